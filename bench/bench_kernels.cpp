@@ -0,0 +1,218 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+/*
+Microbenchmarks of the bitset kernels declared in expand_avx.hpp on
+synthetic matrices (items x samples, density of 1s), for a grid of sizes.
+Each kernel is repeated until it runs for at least -time seconds and the
+mean time per call (ns/op) and the memory bandwidth of the registers it
+reads and writes (GB/s) are reported.
+
+build: g++ -std=c++11 -O2 -mavx2 -pthread -Isrc bench/bench_kernels.cpp src/expand_avx.cpp src/utils.cpp src/stats.cpp src/progress.cpp src/perf.cpp src/memory.cpp src/parallel.cpp -o bench_kernels
+usage: ./bench_kernels [-time <s>] [-items <n>] [-samples <n>] [-density <d>] [-json <file>]
+ */
+
+#include <immintrin.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <stdlib.h>
+
+#include "expand_avx.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+struct Result
+{
+  string kernel;
+  int items;
+  int samples;
+  float density;
+  long calls;
+  double ns_per_op;
+  double gb_per_s;
+};
+
+volatile long sink = 0; //keeps the results of the kernels alive
+
+//random dataset: half cases, half controls, each bit is 1 with probability density
+Transaction make_transaction(int nb_items, int nb_samples, float density, unsigned int seed)
+{
+  Transaction att;
+  att.nb_sample = nb_samples;
+  att.nb_case = nb_samples/2;
+  att.nb_control = nb_samples - att.nb_case;
+  att.case_registers = (att.nb_case + nb_bits - 1)/nb_bits;
+  att.control_registers = (att.nb_control + nb_bits - 1)/nb_bits;
+  int nb_registers = att.case_registers + att.control_registers;
+  att.case_itemset = Tidset_vector(nb_registers, _mm256_setzero_si256());
+  att.control_itemset = Tidset_vector(nb_registers, _mm256_setzero_si256());
+  for(int e=0; e<nb_samples; e++)
+    set_tid((e < att.nb_case) ? att.case_itemset : att.control_itemset, e, att);
+
+  std::mt19937 generator(seed);
+  std::bernoulli_distribution bit(density);
+  for(int i=0; i<nb_items; i++){
+      Tidset_vector row(nb_registers, _mm256_setzero_si256());
+      for(int e=0; e<nb_samples; e++)
+	if(bit(generator)) set_tid(row, e, att);
+      att.push_back(row);
+      ITEM item;
+      item.id = i;
+      item.label = i;
+      item.support = get_size(row);
+      att.tidset.push_back(item);
+    }
+  return att;
+}
+
+//run a kernel until min_time seconds are spent, return the mean time of a call
+Result run(const string& kernel, Transaction& att, float density, double bytes, double min_time, std::function<long()> f)
+{
+  long calls = 0;
+  long batch = 1;
+  double seconds = 0;
+  while(seconds < min_time){
+      std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+      long s = 0;
+      for(long i=0; i<batch; i++) s += f();
+      seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+      sink += s;
+      calls += batch;
+      batch *= 2;
+    }
+  Result r;
+  r.kernel = kernel;
+  r.items = att.size();
+  r.samples = att.nb_sample;
+  r.density = density;
+  r.calls = calls;
+  r.ns_per_op = seconds*1e9/calls;
+  r.gb_per_s = bytes/r.ns_per_op;
+  return r;
+}
+
+void bench_dataset(int nb_items, int nb_samples, float density, double min_time, std::vector<Result>& results)
+{
+  Transaction att = make_transaction(nb_items, nb_samples, density, 1);
+  int nb_registers = att.case_registers + att.control_registers;
+  double row_bytes = nb_registers*sizeof(__m256i);
+
+  //pattern of the first two tids of item 0 and its tidlist (never empty)
+  Poslist tids0 = get_bitset_pos(att[0], att);
+  Tidset_vector p(nb_registers, _mm256_setzero_si256());
+  for(int i=0; i<tids0.size() && i<2; i++) set_tid(p, tids0[i], att);
+  Tidlist tid = compute_tidlist_avx(p, att);
+  Tidset_vector q = att[0];
+  Tidset_vector r = att[nb_items-1];
+  std::shared_ptr<const FisherTable> fisher = get_fisher_table(att.nb_case, att.nb_control);
+  FisherScope tables(*fisher);
+
+  results.push_back(run("compute_tidlist_avx", att, density, nb_items*row_bytes, min_time,
+			[&]{ return (long)compute_tidlist_avx(p, att).size(); }));
+  for(int option=0; option<3; option++)
+    results.push_back(run("compute_closure_avx_" + std::to_string(option), att, density, (tid.size()+1)*row_bytes, min_time,
+			  [&]{ return (long)_mm256_extract_epi64(compute_closure_avx(tid, att, nb_registers, option)[0], 0); }));
+  results.push_back(run("reduced_dataset_avx", att, density, 2*tid.size()*row_bytes, min_time,
+			[&]{ return (long)reduced_dataset_avx(tid, att).size(); }));
+  results.push_back(run("check_itemset_score", att, density, row_bytes, min_time,
+			[&]{ return (long)check_itemset_score(q, att, 1.5, 1, 0, 0, 0); }));
+  results.push_back(run("check_itemset_pvalue", att, density, row_bytes, min_time,
+			[&]{ return (long)check_itemset_pvalue(q, att, 0.05); }));
+  results.push_back(run("predict_expand_avx", att, density, (tid.size()+1)*row_bytes, min_time,
+			[&]{ return (long)predict_expand_avx(tid, 1.5, att, nb_registers); }));
+  results.push_back(run("get_bitset_pos", att, density, row_bytes, min_time,
+			[&]{ return (long)get_bitset_pos(q, att).size(); }));
+  results.push_back(run("get_size", att, density, row_bytes, min_time,
+			[&]{ return (long)get_size(q); }));
+  results.push_back(run("get_support", att, density, row_bytes, min_time,
+			[&]{ int a, c; get_support(q, att, a, c); return (long)(a + c); }));
+  results.push_back(run("check_empty_avx", att, density, row_bytes, min_time,
+			[&]{ return (long)check_empty_avx(q); }));
+  results.push_back(run("min_tidset_avx", att, density, row_bytes, min_time,
+			[&]{ return (long)min_tidset_avx(q, att); }));
+  results.push_back(run("max_tidset_avx", att, density, row_bytes, min_time,
+			[&]{ return (long)max_tidset_avx(q, att); }));
+  results.push_back(run("add_tidset_avx", att, density, 3*row_bytes, min_time,
+			[&]{ return (long)add_tidset_avx(q, r).size(); }));
+  results.push_back(run("remove_tidset_avx", att, density, 3*row_bytes, min_time,
+			[&]{ return (long)remove_tidset_avx(q, r).size(); }));
+}
+
+void print_json(std::ostream& out, std::vector<Result>& results)
+{
+  out<<"["<<endl;
+  for(int i=0; i<results.size(); i++){
+      Result& r = results[i];
+      out<<"  {\"kernel\": \""<<r.kernel<<"\", \"items\": "<<r.items<<", \"samples\": "<<r.samples
+	 <<", \"density\": "<<r.density<<", \"calls\": "<<r.calls<<", \"ns_per_op\": "<<r.ns_per_op
+	 <<", \"gb_per_s\": "<<r.gb_per_s<<"}"<<(i+1 < results.size() ? "," : "")<<endl;
+    }
+  out<<"]"<<endl;
+}
+
+int main(int argc, char* argv[])
+{
+  double min_time = 0.2;
+  std::vector<int> grid_items = {64, 1024};
+  std::vector<int> grid_samples = {256, 2048};
+  std::vector<float> grid_density = {0.05, 0.5};
+  string json_file;
+  for(int i=1; i+1<argc; i+=2){
+      string option = argv[i];
+      if(option=="-time") min_time = atof(argv[i+1]);
+      else if(option=="-items") grid_items = {atoi(argv[i+1])};
+      else if(option=="-samples") grid_samples = {atoi(argv[i+1])};
+      else if(option=="-density") grid_density = {(float)atof(argv[i+1])};
+      else if(option=="-json") json_file = argv[i+1];
+      else cout<<"parameter of "<<argv[i]<<" is invalid"<<endl;
+    }
+
+  std::vector<Result> results;
+  cout<<"#kernel : items : samples : density : ns/op : GB/s"<<endl;
+  for(int i=0; i<grid_items.size(); i++)
+    for(int s=0; s<grid_samples.size(); s++)
+      for(int d=0; d<grid_density.size(); d++){
+	  int first = results.size();
+	  bench_dataset(grid_items[i], grid_samples[s], grid_density[d], min_time, results);
+	  for(int k=first; k<results.size(); k++){
+	      Result& r = results[k];
+	      cout<<r.kernel<<" : "<<r.items<<" : "<<r.samples<<" : "<<r.density<<" : "<<r.ns_per_op<<" : "<<r.gb_per_s<<endl;
+	    }
+	}
+
+  if(!json_file.empty()){
+      ofstream out(json_file.c_str(), ofstream::out);
+      print_json(out, results);
+    }
+  return 0;
+}
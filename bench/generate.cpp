@@ -0,0 +1,52 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+/*
+Write a synthetic dataset in the input format of SSDPS to the standard output.
+
+build: g++ -std=c++11 -O2 bench/generate.cpp bench/generator.cpp -o generate
+usage: ./generate [-items <n>] [-case <n>] [-control <n>] [-density <d>]
+                  [-block <n>] [-correlation <r>] [-patterns <n>] [-pattern-size <n>]
+                  [-pattern-case <f>] [-pattern-control <f>] [-seed <n>] > data.txt
+ */
+
+#include <iostream>
+#include <string>
+
+#include "generator.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+  GeneratorConfig config;
+  for(int i=1; i+1<argc; i+=2)
+    if(!parse_generator_option(config, argv[i], argv[i+1]))
+      cerr<<"parameter of "<<argv[i]<<" is invalid"<<endl;
+  generate_dataset(cout, config);
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <stdlib.h>
+
+#include "generator.hpp"
+
+using namespace std;
+
+void generate_dataset(std::ostream& out, const GeneratorConfig& config)
+{
+  int nb_sample = config.nb_case + config.nb_control;
+  std::mt19937 generator(config.seed);
+  std::bernoulli_distribution background(config.density);
+  std::bernoulli_distribution copy(config.correlation);
+  std::vector<string> rows(config.nb_items, string(nb_sample, '0'));
+
+  //background and correlated blocks
+  string block;
+  for(int i=0; i<config.nb_items; i++){
+      if(i % std::max(1, config.block_size) == 0){
+	  block = string(nb_sample, '0');
+	  for(int s=0; s<nb_sample; s++) if(background(generator)) block[s] = '1';
+	}
+      for(int s=0; s<nb_sample; s++){
+	  bool value = (config.block_size > 1 && copy(generator)) ? (block[s]=='1') : background(generator);
+	  if(value) rows[i][s] = '1';
+	}
+    }
+
+  //planted patterns on random items and random samples of each class
+  std::vector<int> items(config.nb_items);
+  for(int i=0; i<config.nb_items; i++) items[i] = i;
+  std::vector<int> cases(config.nb_case), controls(config.nb_control);
+  for(int s=0; s<config.nb_case; s++) cases[s] = s;
+  for(int s=0; s<config.nb_control; s++) controls[s] = config.nb_case + s;
+  for(int k=0; k<config.nb_patterns; k++){
+      std::shuffle(items.begin(), items.end(), generator);
+      std::shuffle(cases.begin(), cases.end(), generator);
+      std::shuffle(controls.begin(), controls.end(), generator);
+      int size = std::min(config.pattern_size, config.nb_items);
+      for(int i=0; i<size; i++){
+	  for(int s=0; s<config.pattern_case*config.nb_case; s++) rows[items[i]][cases[s]] = '1';
+	  for(int s=0; s<config.pattern_control*config.nb_control; s++) rows[items[i]][controls[s]] = '1';
+	}
+    }
+
+  out<<"# "<<config.nb_case<<" "<<config.nb_control<<endl;
+  for(int i=0; i<config.nb_items; i++) out<<rows[i]<<endl;
+}
+
+//set an option of the generator, return false if the option is unknown or invalid
+int parse_generator_option(GeneratorConfig& config, const string& option, const char* value)
+{
+  float v = atof(value);
+  if(option=="-items" && v>0) config.nb_items = v;
+  else if(option=="-case" && v>0) config.nb_case = v;
+  else if(option=="-control" && v>0) config.nb_control = v;
+  else if(option=="-density" && v>=0 && v<=1) config.density = v;
+  else if(option=="-block" && v>=1) config.block_size = v;
+  else if(option=="-correlation" && v>=0 && v<=1) config.correlation = v;
+  else if(option=="-patterns" && v>=0) config.nb_patterns = v;
+  else if(option=="-pattern-size" && v>=1) config.pattern_size = v;
+  else if(option=="-pattern-case" && v>=0 && v<=1) config.pattern_case = v;
+  else if(option=="-pattern-control" && v>=0 && v<=1) config.pattern_control = v;
+  else if(option=="-seed" && v>=0) config.seed = v;
+  else return false;
+  return true;
+}
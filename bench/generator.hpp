@@ -0,0 +1,70 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#ifndef GENERATOR_HPP_
+#define GENERATOR_HPP_
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////SYNTHETIC DATASETS/////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+Binary matrices in the input format of SSDPS ("# nb_case nb_control" then one
+line of '0'/'1' per item, the cases first).
+Background items are 1 with probability density. Items are grouped in blocks
+of block_size items which copy a common random row with probability
+correlation (correlated items). Planted patterns are sets of pattern_size
+items which are all 1 for a fraction pattern_case of the cases and
+pattern_control of the controls.
+ */
+struct GeneratorConfig
+{
+  int nb_items;
+  int nb_case;
+  int nb_control;
+  float density;
+  int block_size;         //size of the blocks of correlated items (1: no block)
+  float correlation;      //probability to copy the row of the block
+  int nb_patterns;        //number of planted discriminative patterns
+  int pattern_size;       //number of items of a planted pattern
+  float pattern_case;     //fraction of the cases containing a planted pattern
+  float pattern_control;  //fraction of the controls containing a planted pattern
+  unsigned int seed;
+
+  GeneratorConfig() : nb_items(100), nb_case(100), nb_control(100), density(0.2), block_size(1), correlation(0),
+		      nb_patterns(0), pattern_size(3), pattern_case(0.4), pattern_control(0.05), seed(0) {}
+};
+
+void generate_dataset(std::ostream& out, const GeneratorConfig& config);
+int parse_generator_option(GeneratorConfig& config, const string& option, const char* value);
+
+#endif /* GENERATOR_HPP_ */
@@ -0,0 +1,229 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+/*
+End-to-end scaling benchmark: generates datasets over a grid of item and
+sample counts, runs SSDPS in exhaustive and heuristic mode on each of them
+and records the wall-clock time, the peak resident memory (ru_maxrss of the
+child process) and the number of patterns.
+With -baseline, the runs are compared with a stored result: the harness
+fails (exit code 1) if a run is slower than the baseline by more than the
+tolerance, or finds a different number of patterns.
+
+build: g++ -std=c++11 -O2 bench/scaling.cpp bench/generator.cpp -o scaling
+usage: ./scaling [-bin <SSDPS>] [-items <n,n,..>] [-samples <n,n,..>] [-or <n>] [-iteration <n>]
+                 [-save <file>] [-baseline <file>] [-tolerance <f>] [-noise <s>] [generator options]
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "generator.hpp"
+
+using namespace std;
+
+struct Run
+{
+  string mode;
+  int items;
+  int samples;
+  float density;
+  double seconds;
+  long max_rss;  //peak resident memory (KB)
+  long patterns;
+  int status;    //exit status of SSDPS
+  int stopped;   //1 if the search stopped before its end ("#nb_patterns: n", exit status 1)
+};
+
+std::vector<int> parse_list(const string& str)
+{
+  std::vector<int> result;
+  stringstream ss(str);
+  string tok;
+  while(getline(ss, tok, ',')) result.push_back(atoi(tok.c_str()));
+  return result;
+}
+
+//run SSDPS on a dataset, its output goes to a temporary file which is parsed for #nb_patterns
+Run run_ssdps(const string& bin, std::vector<string> args, const string& data_file)
+{
+  Run run;
+  run.patterns = -1;
+  char out_file[] = "/tmp/ssdps_scaling_outXXXXXX";
+  int fd = mkstemp(out_file);
+
+  args.insert(args.begin(), bin);
+  args.push_back(data_file);
+  std::vector<char*> argv;
+  for(int i=0; i<args.size(); i++) argv.push_back((char*)args[i].c_str());
+  argv.push_back(NULL);
+
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if(pid == 0){
+      dup2(fd, 1);
+      int null_fd = open("/dev/null", O_WRONLY);
+      dup2(null_fd, 2);
+      execv(bin.c_str(), &argv[0]);
+      _exit(127);
+    }
+  int status = 0;
+  struct rusage usage;
+  wait4(pid, &status, 0, &usage);
+  run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  run.max_rss = usage.ru_maxrss;
+  run.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  close(fd);
+
+  ifstream out(out_file);
+  string line;
+  run.stopped = 0;
+  while(getline(out, line)){
+      if(line.compare(0, 13, "#nb_patterns ") == 0) run.patterns = atol(line.c_str() + 13);
+      if(line.compare(0, 14, "#nb_patterns: ") == 0){
+	  run.patterns = atol(line.c_str() + 14);
+	  run.stopped = 1;
+	}
+    }
+  unlink(out_file);
+  return run;
+}
+
+string run_key(const Run& run)
+{
+  stringstream ss;
+  ss<<run.mode<<" "<<run.items<<" "<<run.samples<<" "<<run.density;
+  return ss.str();
+}
+
+int main(int argc, char* argv[])
+{
+  string bin = "./SSDPS";
+  std::vector<int> grid_items = {25, 50, 100};
+  std::vector<int> grid_samples = {100, 200, 400};
+  string or_threshold = "2";
+  string iteration = "1";
+  string save_file, baseline_file;
+  float tolerance = 0.3;
+  float noise = 0.1;   //time differences below this (s) are not regressions
+  GeneratorConfig config;
+  config.nb_patterns = 2;
+  for(int i=1; i+1<argc; i+=2){
+      string option = argv[i];
+      if(option=="-bin") bin = argv[i+1];
+      else if(option=="-items") grid_items = parse_list(argv[i+1]);
+      else if(option=="-samples") grid_samples = parse_list(argv[i+1]);
+      else if(option=="-or") or_threshold = argv[i+1];
+      else if(option=="-iteration") iteration = argv[i+1];
+      else if(option=="-save") save_file = argv[i+1];
+      else if(option=="-baseline") baseline_file = argv[i+1];
+      else if(option=="-tolerance") tolerance = atof(argv[i+1]);
+      else if(option=="-noise") noise = atof(argv[i+1]);
+      else if(!parse_generator_option(config, option, argv[i+1]))
+	cerr<<"parameter of "<<argv[i]<<" is invalid"<<endl;
+    }
+
+  //runs of the baseline by key
+  std::vector<Run> baseline;
+  if(!baseline_file.empty()){
+      ifstream in(baseline_file.c_str());
+      string line;
+      while(getline(in, line)){
+	  if(line.empty() || line[0]=='#') continue;
+	  stringstream ss(line);
+	  Run run;
+	  ss>>run.mode>>run.items>>run.samples>>run.density>>run.seconds>>run.max_rss>>run.patterns;
+	  baseline.push_back(run);
+	}
+    }
+
+  std::vector<Run> runs;
+  int failures = 0;
+  cout<<"#mode items samples density seconds max_rss_kb patterns"<<endl;
+  for(int i=0; i<grid_items.size(); i++)
+    for(int s=0; s<grid_samples.size(); s++){
+	config.nb_items = grid_items[i];
+	config.nb_case = grid_samples[s]/2;
+	config.nb_control = grid_samples[s] - config.nb_case;
+	char data_file[] = "/tmp/ssdps_scaling_dataXXXXXX";
+	int fd = mkstemp(data_file);
+	close(fd);
+	{
+	  ofstream data(data_file);
+	  generate_dataset(data, config);
+	}
+
+	for(int m=0; m<2; m++){
+	    std::vector<string> args;
+	    if(m==1){ args.push_back("-heuristics"); args.push_back("-iteration"); args.push_back(iteration); }
+	    args.push_back("-or"); args.push_back(or_threshold);
+	    Run run = run_ssdps(bin, args, data_file);
+	    run.mode = (m==0) ? "exhaustive" : "heuristic";
+	    run.items = config.nb_items;
+	    run.samples = grid_samples[s];
+	    run.density = config.density;
+	    cout<<run_key(run)<<" "<<run.seconds<<" "<<run.max_rss<<" "<<run.patterns;
+	    //the heuristic search stopping at -iteration exits with code 1, it is not a failure
+	    int heuristic_stop = (m==1) && run.stopped && (run.status==1);
+	    if((run.status != 0) && !heuristic_stop) { cout<<" FAILED (exit "<<run.status<<")"; failures++; }
+
+	    for(int b=0; b<baseline.size(); b++)
+	      if(run_key(baseline[b]) == run_key(run)){
+		  if(baseline[b].patterns != run.patterns) { cout<<" MISMATCH (baseline "<<baseline[b].patterns<<" patterns)"; failures++; }
+		  if( (run.seconds > baseline[b].seconds*(1+tolerance)) && (run.seconds - baseline[b].seconds > noise) ){
+		      cout<<" REGRESSION (baseline "<<baseline[b].seconds<<" s)";
+		      failures++;
+		    }
+		}
+	    cout<<endl;
+	    runs.push_back(run);
+	  }
+	unlink(data_file);
+      }
+
+  if(!save_file.empty()){
+      ofstream out(save_file.c_str());
+      out<<"#mode items samples density seconds max_rss_kb patterns"<<endl;
+      for(int r=0; r<runs.size(); r++)
+	out<<run_key(runs[r])<<" "<<runs[r].seconds<<" "<<runs[r].max_rss<<" "<<runs[r].patterns<<endl;
+    }
+
+  if(failures > 0){
+      cout<<"#"<<failures<<" failed runs"<<endl;
+      return 1;
+    }
+  return 0;
+}
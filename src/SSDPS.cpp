@@ -43,11 +43,22 @@
 #include <vector>
 #include <bitset> 
 #include <map>
+#include <algorithm>
+#include <chrono>
 #include <stdlib.h>
 
 #include "utils.hpp"
-#include "exhaustiveSearch.hpp"
-#include "heuristicSearch.hpp"
+#include "miner.hpp"
+#include "loader.hpp"
+#include "server.hpp"
+#include "lattice.hpp"
+#include "sweep.hpp"
+#include "increment.hpp"
+#include "outofcore.hpp"
+#include "plink.hpp"
+#include "stats.hpp"
+#include "perf.hpp"
+#include "parallel.hpp"
 
 using namespace std;
 
@@ -62,19 +73,37 @@ using namespace std;
   float arr_threshold = 0;   //absolute risk reduction threshold
   float lci_threshold = 1;   //lower confidence interval of odd ratio
   float p_val = 0;           //p-value threshold 
+  float lamp_alpha = 0;      //family-wise error rate of LAMP multiple testing correction (0: not used)
+  float wy_alpha = 0;        //family-wise error rate of Westfall-Young permutation testing (0: not used)
+  int nb_permutations = 1000; //number of permutations of Westfall-Young
+  int seed = 0;             //seed of the random permutations
   float max_control = 0;     //maximal number of control individuals containing items
   float min_case = 0;        //minimal number of case individuals containing items
   float min_case_out = 0;    //minimal number of case individual containing patterns
   int it_threshold = 1000000; //number of searching steps threshold 
   int nb_sample = 0;        //number of sample
   int method = 0;           //searching method. 0: exhaustive search, 1: heuristic search (searching the largest patterns)
+  int case_order = 0;       //order of case samples by support. 0: file order, 1: ascending, -1: descending
+  int item_order = 0;       //order of items by support. 0: file order, 1: ascending, -1: descending
+  int stats_format = STATS_NONE; //search statistics printed at exit: none, text or json
+  float progress_interval = 0; //seconds between two progress reports (0: not used)
+  string progress_file;     //status file of the progress reports (default error output)
+  int perf_mode = 0;        //1: count hardware events of the phases and kernels
+  string socket_path;       //Unix domain socket of the server mode (empty: not used)
+  int nb_threads = 0;       //number of threads answering the queries of the server (0: number of cores)
+  string lattice_output;    //file of the patterns saved for later queries (empty: not used)
+  string lattice_file;      //file of saved patterns answering the query instead of mining (empty: not used)
+  string sweep_file;        //file of threshold configurations mined in one search (empty: not used)
+  string delta_file;        //file of new items or samples mined incrementally (empty: not used)
+  int delta_samples = 0;    //1: the delta file holds new samples, 0: new items
+  string input_output;      //file of the updated matrix of the incremental mining (empty: not used)
+  float mem_limit = 0;      //memory limit of the tidsets in MB (0: no limit)
+  int kernel_threads = 1;   //number of threads of the kernels on large datasets (1: serial, 0: number of cores)
+  int genotype = GENOTYPE_DOMINANT; //items of the SNPs of a PLINK input (.bed): dominant, recessive or allele
+  int print_samples = 0;    //1: print the ids of the samples containing each pattern
+  float out_of_core = 0;    //budget of the projected datasets of the out-of-core mining in MB (0: the file is loaded)
 
   ///////////////////////////////////////////////////////////
-  //convert string to int
-  constexpr unsigned int str2int(const char* str, int h = 0){
-      return !str[h] ? 5381 : (str2int(str, h+1) * 33) ^ str[h];
-  }
-
   //split string by delimiter
   vector<string> split(string str, char delimiter) {
     vector<string> internal;
@@ -86,6 +115,14 @@ using namespace std;
     return internal;
   }
 
+  //parse the value of an ordering option: asc = 1, desc = -1, otherwise 0
+  int parse_order(const char* str) {
+    string v(str);
+    if(v=="asc") return 1;
+    if(v=="desc") return -1;
+    return 0;
+  }
+
 
 int main(int argc, char* argv[]) {
   
@@ -99,15 +136,45 @@ int main(int argc, char* argv[]) {
       cout<<"-or: odds ratio threshold (default 1)" <<endl;
       cout<<"-rr: risk ratio threshold (default 1)"<<endl;
       cout<<"-ar: absolute risk reduction threshold (default 0)"<<endl;
-//      cout<<"-pval: p-val threshold (default 0)"<<endl;
+      cout<<"-pval: p-value threshold of Fisher's exact test (default 0: not used)"<<endl;
+      cout<<"-lamp: family-wise error rate, corrects the p-value threshold for multiple testing (default 0: not used)"<<endl;
+      cout<<"-wy: family-wise error rate, corrects the p-value threshold by Westfall-Young permutations (default 0: not used)"<<endl;
+      cout<<"-perm: number of permutations of -wy (default 1000)"<<endl;
+      cout<<"-seed: seed of the random permutations (default 0)"<<endl;
       cout<<"-min: minimal support in the 1st class (default 0%)"<<endl;
       cout<<"-max: maximal support in the 2nd class (default 100%)"<<endl;
 //      cout<<"-min: minimal case support of output pattern (default 0%)"<<endl;
 	  cout<<"-heuristics: mining the largest patterns (default exhaustive mining)"<<endl;
       cout<<"-iteration: number of iteration x 1,000,000 (default 1,000,000 interations)"<<endl;
+      cout<<"-order-case: order case samples by support, asc or desc (default file order)"<<endl;
+      cout<<"-order-item: order items by support, asc or desc (default file order)"<<endl;
+      cout<<"-stats: print search statistics at exit, text (output) or json (error output)"<<endl;
+      cout<<"-progress: report the progress every n seconds to the error output (default 0: not used)"<<endl;
+      cout<<"-progress-file: write the progress reports to a status file instead"<<endl;
+      cout<<"-perf: count cycles, instructions, LLC and branch misses of the phases and kernels"<<endl;
+      cout<<"-mem-limit: memory limit of the search in MB, the output is partial if it is reached (default 0: no limit)"<<endl;
+      cout<<"-serve: load the data once and answer queries on a Unix domain socket"<<endl;
+      cout<<"-threads: number of threads answering the queries of -serve (default number of cores)"<<endl;
+      cout<<"-kernel-threads: number of threads scanning the items of large datasets, 0: number of cores (default 1)"<<endl;
+      cout<<"-genotype: items of the SNPs of a PLINK input (.bed), dominant, recessive or allele (default dominant)"<<endl;
+      cout<<"-print-samples: print the ids of the samples containing each pattern after its scores"<<endl;
+      cout<<"-out-of-core: mine without loading the input, seeds by batches of projected data of at most n MB"<<endl;
+      cout<<"-save-lattice: save the patterns of the exhaustive search to a file for -lattice"<<endl;
+      cout<<"-lattice: answer from a file of -save-lattice with stricter thresholds instead of mining"<<endl;
+      cout<<"-sweep: mine the threshold configurations of a file (one per line) in one search"<<endl;
+      cout<<"-delta-items: mine the input with new items, from the patterns of the previous run (-lattice)"<<endl;
+      cout<<"-delta-samples: mine the input with new samples"<<endl;
+      cout<<"-save-input: write the updated matrix of -delta-items or -delta-samples to a file"<<endl;
       return 0;
     }else{
       input_file = argv[argc-1];
+      if(is_plink_file(input_file)){
+	  //the classes of the samples are in the .fam of a PLINK fileset
+	  if(!read_plink_header(input_file, nb_case, nb_control)){
+	      cout<<"#error: cannot read the .fam of "<<input_file<<endl;
+	      return 1;
+	    }
+	} else {
       ifstream para (input_file.c_str() , ifstream::in);
 	  //read the first line of input file to find the number of case and control
 	  string first_line;
@@ -115,12 +182,14 @@ int main(int argc, char* argv[]) {
       vector<string> sample_size = split(first_line,' ');
       nb_case    = std::stoi(sample_size[1]);
       nb_control = std::stoi(sample_size[2]); 
+	  para.close();
+	}
       nb_sample  = nb_case+nb_control;
   	  max_control =  nb_control;
-	  para.close();
 	  /////////////////////////
 	  float temp;	  
-  	  for(int i=1; i<argc-2; ++i){
+  	  //the last argument is the input file, options without value may come just before it
+  	  for(int i=1; i<argc-1; ++i){
 		  switch(str2int(argv[i])){
 			case str2int("-or"):
 			  temp = strtof(argv[i+1],&argv[i+1]);
@@ -146,10 +215,53 @@ int main(int argc, char* argv[]) {
 				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
 			  break;
 
+			case str2int("-pval"):
+			case str2int("-p-value"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>0 && temp<=1)
+				  p_val = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			case str2int("-lamp"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>0 && temp<=1)
+				  lamp_alpha = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			case str2int("-wy"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>0 && temp<=1)
+				  wy_alpha = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			case str2int("-perm"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>=1)
+				  nb_permutations = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			case str2int("-seed"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>=0)
+				  seed = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
 			case str2int("-min"):
 			  temp = strtof(argv[i+1],&argv[i+1]);
-			  if(temp!=0)
+			  if(temp!=0){
 				  min_case = (temp/100)*nb_case*100;
+				  min_case_out = min_case;
+			  }
 			  else
 				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
 			  break;
@@ -166,6 +278,115 @@ int main(int argc, char* argv[]) {
   				  method = 1;
 				  break;
 			
+			  case str2int("-order-case"):
+			  case_order = parse_order(argv[i+1]);
+			  if(case_order==0)
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-order-item"):
+			  item_order = parse_order(argv[i+1]);
+			  if(item_order==0)
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-stats"):
+			  if(string(argv[i+1])=="text") stats_format = STATS_TEXT;
+			  else if(string(argv[i+1])=="json") stats_format = STATS_JSON;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-progress"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>0)
+				  progress_interval = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-perf"):
+  				  perf_mode = 1;
+				  break;
+
+			  case str2int("-print-samples"):
+  				  print_samples = 1;
+				  break;
+
+			  case str2int("-progress-file"):
+			  progress_file = argv[i+1];
+			  break;
+
+			  case str2int("-save-lattice"):
+			  lattice_output = argv[i+1];
+			  break;
+
+			  case str2int("-lattice"):
+			  lattice_file = argv[i+1];
+			  break;
+
+			  case str2int("-sweep"):
+			  sweep_file = argv[i+1];
+			  break;
+
+			  case str2int("-delta-items"):
+			  delta_file = argv[i+1];
+			  delta_samples = 0;
+			  break;
+
+			  case str2int("-delta-samples"):
+			  delta_file = argv[i+1];
+			  delta_samples = 1;
+			  break;
+
+			  case str2int("-mem-limit"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>0)
+				  mem_limit = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-save-input"):
+			  input_output = argv[i+1];
+			  break;
+
+			  case str2int("-serve"):
+			  socket_path = argv[i+1];
+			  break;
+
+			  case str2int("-kernel-threads"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>=0)
+				  kernel_threads = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-genotype"):
+			  if(string(argv[i+1])=="dominant") genotype = GENOTYPE_DOMINANT;
+			  else if(string(argv[i+1])=="recessive") genotype = GENOTYPE_RECESSIVE;
+			  else if(string(argv[i+1])=="allele") genotype = GENOTYPE_ALLELE;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-out-of-core"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>0)
+				  out_of_core = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
+			  case str2int("-threads"):
+			  temp = strtof(argv[i+1],&argv[i+1]);
+			  if(temp>=1)
+				  nb_threads = temp;
+			  else
+				  cout <<"parameter of "<< argv[i]<< " is invalid"<< endl;
+			  break;
+
   			  case str2int("-iteration"):
 			  temp = strtof(argv[i+1],&argv[i+1]);
 			  if(temp!=0)
@@ -206,202 +427,197 @@ int main(int argc, char* argv[]) {
 */
 
 
-  //////////load input data into transactionTable/////
-    Transaction transaction;//tt_v;
-    int nb_trans = 0;
-    ifstream database (input_file.c_str() , ifstream::in);
-
- //initial registers and masks
-  int nb_registers = 0; //nb of register using
-  if ( (nb_sample % nb_bits)==0 ) 
-	  nb_registers = (nb_sample / nb_bits);
-  else 
-	  nb_registers = (nb_sample / nb_bits) + 1;
-
-  //cout<<"nb_registers "<<nb_registers<<endl;
-   
-  while(database.good())    {
-      //read line
-      string line;
-      getline(database,line);
-      if(!line.empty() && (line[0]!='#'))	{
-	  int bb_case = 0;
-	  int bb_control = 0;
-	  for(int i=0; i<nb_sample; i++)
-	    if(line[i]=='1'){
-	      if (i<nb_case) bb_case++;
-	      else bb_control++;}
-	  //double p = std::stod(p_value[bb_case][bb_control]); //get p-value of the current item
-	  float p = p_value(bb_case,nb_case-bb_case,bb_control,nb_control-bb_control);
-      //select items based on p-value, case and control support
-	  if(p_val!=0)  {
-	      if( (p <= p_val) && (p > 0) && (bb_control <= max_control) && (bb_case >= min_case) ){
-		  ITEM tid;
-		  tid.id = nb_trans;
-		  tid.label = nb_trans;
-		  transaction.tidset.push_back(tid);	  
-		  //add line to tt_v
-		  int kk=0;
-		  __m256i mask = _mm256_set1_epi32(-1);
-		  int i=0; //nb_registers
-		  int n=nb_bits*nb_registers-1; //total bits reading
-		  aligned_vector tmp;
-
-		  while(i<nb_registers){
-		      int j=0; //nb_chunks
-		      int arr[nb_chunks];
-		      while(j<nb_chunks){
-			  std::bitset<32> bs;
-			  int l=0;
-			  while(l<32){ //transform 32 bits into int and put it into arr[j]
-			      if(n<nb_sample) {int a = (int)line[kk]-48; bs[l]= a; kk++;}
-			      else bs[l]=0;
-			      l++;
-			      n--;
-			    }
-			  //cout<<bs<<endl;
-			  arr[j]=bs.to_ulong();
-			  j++;
-			}
-		      __m256i x_tmp = _mm256_maskload_epi32(arr,mask);
-		      tmp.push_back(x_tmp);
-		      i++;
-		    }
-		  transaction.push_back(tmp);
-		}
-		 //select items based on case and control supports
-	    }else {
-	    if( (bb_control <= max_control) && (bb_case >= min_case) ){
-		  //add tid to to tt_v
-		  ITEM tid;
-		  tid.id = nb_trans;
-		  tid.label = nb_trans;
-		  transaction.tidset.push_back(tid);	  
-
-		  //add line to tt_v
-		  int kk=0;
-		  __m256i mask = _mm256_set1_epi32(-1);
-		  int i=0; //nb_registers
-		  int n=nb_bits*nb_registers-1; //total bits reading
-		  aligned_vector tmp;
-
-		  while(i<nb_registers){
-		      int j=0; //nb_chunks
-		      int arr[nb_chunks];
-		      while(j<nb_chunks){
-			  std::bitset<32> bs;
-			  int l=0;
-			  while(l<32){ //transform 32 bits into int and put it into arr[j]
-			      if(n<nb_sample) {int a = (int)line[kk]-48; bs[l]= a; kk++;}
-			      else bs[l]=0;
-			      l++;
-			      n--;
-			    }
-			  //cout<<bs<<endl;
-			  arr[j]=bs.to_ulong();
-			  j++;
-			}
-		      __m256i x_tmp = _mm256_maskload_epi32(arr,mask);
-		      tmp.push_back(x_tmp);
-		      i++;
-		    }
-		  transaction.push_back(tmp);
-		}
-	  }
-	  nb_trans++;
-	}
+  if(stats_format!=STATS_NONE) print_stats_at_exit(stats_format);
+  if(progress_interval!=0) start_progress(progress_interval, progress_file);
+  if(perf_mode && init_perf()) print_perf_at_exit();
+  if(mem_limit!=0) set_memory_limit(mem_limit*1024*1024);
+  if(kernel_threads!=1) init_kernel_threads(kernel_threads);
+
+  MinerConfig config;
+  config.or_threshold = or_threshold;
+  config.rr_threshold = rr_threshold;
+  config.arr_threshold = arr_threshold;
+  config.p_value = p_val;
+  config.min_case = min_case;
+  config.max_control = max_control;
+  config.min_case_out = min_case_out;
+  config.method = method;
+  config.it_threshold = it_threshold;
+  config.lamp_alpha = lamp_alpha;
+  config.wy_alpha = wy_alpha;
+  config.nb_permutations = nb_permutations;
+  config.seed = seed;
+
+  if((mem_limit!=0) && !socket_path.empty()){
+      //the memory accounting and its limit are shared by the whole process, not by each query
+      cout<<"#error: -mem-limit cannot be used with -serve"<<endl;
+      return 1;
+    }
+  if(is_plink_file(input_file) && (!sweep_file.empty() || !delta_file.empty() || (out_of_core!=0))){
+      cout<<"#error: -sweep, -delta-items, -delta-samples and -out-of-core read matrix files, not PLINK filesets"<<endl;
+      return 1;
+    }
+  if(is_sparse_file(input_file) && (!delta_file.empty() || (out_of_core!=0))){
+      cout<<"#error: -delta-items, -delta-samples and -out-of-core read dense matrix files, not sparse ones"<<endl;
+      return 1;
+    }
+  if((out_of_core!=0) && (print_samples || !lattice_output.empty() || !lattice_file.empty() || !socket_path.empty() || (item_order!=0))){
+      //the out-of-core mining only prints the patterns of the exhaustive search
+      cout<<"#error: -print-samples, -save-lattice, -lattice, -serve and -order-item cannot be used with -out-of-core"<<endl;
+      return 1;
     }
+  if(print_samples && (case_order!=0)){
+      //the sample ids are the columns of the input
+      cout<<"#error: -print-samples cannot be used with -order-case"<<endl;
+      return 1;
+    }
+  if(!sweep_file.empty()) return run_sweep(sweep_file, input_file, max_control, case_order, item_order);
+  if(!delta_file.empty()) return run_increment(lattice_file, input_file, delta_file, delta_samples, config, case_order, item_order, input_output, lattice_output);
 
-  //init other values for tt_v
-  transaction.nb_case = nb_case;//number of case samples
-  transaction.nb_control = nb_control; //number of control samples
-  transaction.nb_sample = nb_case+nb_control; //total number of samples
-
-  //init itemset of case group
-  int n = nb_bits*nb_registers;
-  int pos = 0;
-  for(int i=0; i<nb_registers; i++) {
-    __m256i t = _mm256_setzero_si256();
-    for(int j=0; j<256; j++) {
-      if(pos >= (n-nb_sample) && pos < (n-nb_control) )
-	 SetBit(t, pos-i*256, 1);
-      pos++;
-      }
-    transaction.case_itemset.push_back(t);
+  if(out_of_core!=0) return run_out_of_core(input_file, config, out_of_core*1024*1024, case_order);
+
+  if(!lattice_file.empty()){
+      //answer from the patterns saved by -save-lattice, the input file is not loaded
+      std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+      cout<<"#Querying the closed patterns of "<<lattice_file<<endl;
+      cout<<"#risk thresholds (OR, GR, DS): "<<or_threshold<<", "<<rr_threshold<<", "<<arr_threshold<<endl;
+      if(p_val!=0) cout<<"#p_value_threshold: "<<p_val<<endl;
+      cout<<"#min case output: "<<(min_case_out/nb_case)*100<<"%"<<endl;
+      cout<<endl<<"Output:"<<endl;
+      if(p_val!=0) cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) : p-value )"<<endl;
+      else cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
+      LatticeHeader header;
+      string error;
+      long nb_patterns = query_lattice(lattice_file, config, [&](const vector<int>& items, int a, int c){ print_pattern(cout, items, a, c, nb_case, nb_control, p_val, method); }, header, error);
+      if(nb_patterns < 0){
+	  cout<<"#error: "<<error<<endl;
+	  return 1;
+	}
+      cout<<endl<<"#nb_patterns "<<nb_patterns<<" (of "<<header.nb_patterns<<" saved)"<<endl;
+      std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+      cout<<"#running time "<<std::chrono::duration<float>(end-begin).count()<<" s"<<endl;
+      return 0;
     }
 
-  //init itemset of control group
-  pos = 0;
-  for(int i=0; i<nb_registers; i++) {
-    __m256i t = _mm256_setzero_si256();
-    for(int j=0; j<256; j++) {
-      if(pos >= (n-nb_control) )
-	 SetBit(t, pos-i*256, 1);
-      pos++;
+  //////////load input data into transactionTable/////
+  int nb_trans = 0;
+  vector<string> item_names; //names of the items of a PLINK fileset (empty: the labels are printed)
+  auto load_input = [&](float min_sup, float max_sup, Transaction& transaction){
+    if(!is_plink_file(input_file)){
+	transaction = load_transaction(input_file, min_sup, max_sup, case_order, item_order, nb_trans);
+	return true;
       }
-    transaction.control_itemset.push_back(t);
+    string error;
+    if(!load_plink(input_file, genotype, min_sup, max_sup, case_order, item_order, transaction, nb_trans, item_names, error)){
+	cout<<"#error: "<<error<<endl;
+	return false;
+      }
+    return true;
+  };
+  if(!socket_path.empty()){
+      //all items are kept, each query selects its items
+      Transaction transaction;
+      if(!load_input(0, -1, transaction)) return 1;
+      return serve(socket_path, transaction, nb_threads);
     }
+  Transaction transaction;
+  if(!load_input(min_case, max_control, transaction)) return 1;
 
+  Miner miner(std::move(transaction), config);
 
  /////////////////////////////////////////
  //////discriminative pattern mining//////
  /////////////////////////////////////////
-  clock_t begin = clock();
-  int nb_patterns = 0;//number of output patterns
-  int nb_pruning_case = 0; //number of pruning nodes in case group
-  int nb_pruning_control=0; //number of pruning nodes in control group
-  int nb_it = 0; //number of iterations (running steps)
+  PhaseTimer mine_timer(PHASE_MINE);
+  PerfScope mine_perf(PERF_MINE);
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
   if(method==1){
       cout<<"#Heuristic mining statistically significant discriminative patterns"<<endl;
-      cout<<"#size of data: "<<nb_trans<<" x "<<transaction.nb_sample<<endl;
-      cout<<"#size of reduced data: "<<transaction.size()<<" x "<<transaction.nb_sample<<endl;
-      cout<<"#risk thresholds (OR, GR, DS): "<<or_threshold<<", "<<rr_threshold<<", "<<arr_threshold<<endl;
-      if(p_val!=0) cout<<"#p_value_threshold: "<<p_val<<endl;
-      cout<<"#min case support: "<<(min_case/nb_case)*100<<"%"<<endl;
-      cout<<"#max control support: "<<(max_control/nb_control)*100<<"%"<<endl;
-      cout<<"#min case output: "<<(min_case_out/nb_case)*100<<"%"<<endl;
-      cout<<"#stopping steps: "<<it_threshold<<endl;
-      cout<<endl<<"Output:"<<endl;
-      cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
-	  //start from largest tid
-      for(int e=nb_case-1; e>=min_case; e--){
-	  Tidset_vector p; //creat an empty transaction set (tidset)
-	  //init p
-	  for(int i=0; i<nb_registers; i++){
-	      __m256i t = _mm256_setzero_si256();
-	      p.push_back(t);
-	    }
-	  //expand p wich each of tid in case (e)
-		expand_case_heu(p, e, or_threshold, rr_threshold, arr_threshold, min_case_out, it_threshold, nb_patterns, nb_pruning_case, transaction, nb_registers, nb_it);
-	}
-	 //Find all statistically significant discriminative patterns (exhaustive search)
     } else {
+      //1st pass of the multiple testing correction, nothing is output
+      miner.correct();
+      if(wy_alpha!=0){
+	  cout<<"#WY family-wise error rate: "<<wy_alpha<<endl;
+	  cout<<"#WY permutations: "<<nb_permutations<<" (seed "<<seed<<")"<<endl;
+	  cout<<"#WY closed patterns: "<<miner.nb_closed<<endl;
+	  cout<<"#WY subtrees pruned: "<<miner.sig.nb_pruning<<endl;
+	  cout<<"#WY corrected level: "<<miner.sig.delta<<" (p-value < level)"<<endl;
+	} else if(lamp_alpha!=0){
+	  cout<<"#LAMP family-wise error rate: "<<lamp_alpha<<endl;
+	  cout<<"#LAMP closed patterns: "<<miner.nb_closed<<endl;
+	  cout<<"#LAMP testable patterns: "<<miner.sig.k<<endl;
+	  cout<<"#LAMP untestable subtrees pruned: "<<miner.sig.nb_pruning<<endl;
+	  cout<<"#LAMP corrected level: "<<miner.sig.delta<<endl;
+	}
+      //the 2nd pass mines with the corrected level as p-value threshold
+      p_val = miner.config.p_value;
       cout<<"#Exhaustive mining statistically significant discriminative patterns"<<endl;
-      cout<<"#size of data: "<<nb_trans<<" x "<<transaction.nb_sample<<endl;
-      cout<<"#size of reduced data: "<<transaction.size()<<" x "<<transaction.nb_sample<<endl;
-      cout<<"#risk thresholds (OR, GR, DS): "<<or_threshold<<", "<<rr_threshold<<", "<<arr_threshold<<endl;
-      if(p_val!=0) cout<<"#p_value_threshold: "<<p_val<<endl;
-      cout<<"#min case support: "<<(min_case/nb_case)*100<<"%"<<endl;
-      cout<<"#max control support: "<<(max_control/nb_control)*100<<"%"<<endl;
-      cout<<"#min case output: "<<(min_case_out/nb_case)*100<<"%"<<endl;
-      cout<<endl<<"Output:"<<endl;
-      cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
-      //start from the smallest tid
-      for(int e=min_case; e<transaction.nb_case; e++){
-	  Tidset_vector p; //creat an empty transaction set (tidset)
-	  for(int i=0; i<nb_registers; i++){
-	      __m256i t = _mm256_setzero_si256();
-	      p.push_back(t);
-	    }
-	  //expand p with each tid in case group
-	  expand_case_exh(p, e, or_threshold, rr_threshold, arr_threshold, min_case_out, nb_patterns, nb_pruning_case, transaction, nb_registers, nb_pruning_control);
+    }
+  cout<<"#size of data: "<<nb_trans<<" x "<<miner.transaction.nb_sample<<endl;
+  cout<<"#size of reduced data: "<<miner.transaction.size()<<" x "<<miner.transaction.nb_sample<<endl;
+  cout<<"#risk thresholds (OR, GR, DS): "<<or_threshold<<", "<<rr_threshold<<", "<<arr_threshold<<endl;
+  if(p_val!=0) cout<<"#p_value_threshold: "<<p_val<<endl;
+  cout<<"#min case support: "<<(min_case/nb_case)*100<<"%"<<endl;
+  cout<<"#max control support: "<<(max_control/nb_control)*100<<"%"<<endl;
+  cout<<"#min case output: "<<(min_case_out/nb_case)*100<<"%"<<endl;
+  if(method==1) cout<<"#stopping steps: "<<it_threshold<<endl;
+  cout<<endl<<"Output:"<<endl;
+  if(p_val!=0) cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) : p-value )"<<endl;
+  else cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
+
+  LatticeWriter lattice;
+  int save_lattice = !lattice_output.empty() && (method==0);
+  vector<int> label_row; //row of each selected item in the dataset (-print-samples)
+  if(print_samples){
+      label_row.assign(nb_trans, -1);
+      for(int r=0; r<miner.transaction.size(); r++) label_row[miner.transaction.tidset[r].label] = r;
+    }
+  long nb_patterns = miner.mine([&](const vector<int>& items, int a, int c){
+      vector<int> samples;
+      if(print_samples){
+	  vector<int> rows;
+	  for(int i=0; i<items.size(); i++) rows.push_back(label_row[items[i]]);
+	  Poslist tids = get_rows_pos(rows, miner.transaction);
+	  samples.assign(tids.begin(), tids.end());
 	}
+      print_pattern(cout, items, a, c, nb_case, nb_control, p_val, method, item_names.empty() ? nullptr : &item_names, print_samples ? &samples : nullptr);
+      if(save_lattice) lattice.add(items, a, c);
+    });
+  if(memory_exhausted){
+      //the search stopped at the memory limit
+      cout<<"#memory limit reached ("<<mem_limit<<" MB): the output is partial"<<endl;
+      cout<<"#nb_patterns: "<<nb_patterns<<endl;
+      return 1;
+    }
+  if(miner.stopped){
+      //the heuristic search reached the number of searching steps
+      cout<<"#nb_patterns: "<<nb_patterns<<endl;
+      return 1;
     }
   //cout<<endl<<"#nb_prunes "<<nb_prunes<<endl;
   cout<<endl<<"#nb_patterns "<<nb_patterns<<endl;
   //cout<<endl<<"#nb_pruning_control "<<nb_pruning_control<<endl;
-  clock_t end = clock();
-  cout<<"#running time "<<(float)(end-begin)/CLOCKS_PER_SEC<<" s"<<endl;
+  if(save_lattice){
+      //thresholds of the run: the queries of -lattice must be at least as strict
+      LatticeHeader header;
+      header.nb_case = nb_case;
+      header.nb_control = nb_control;
+      header.nb_items = nb_trans;
+      header.nb_selected = miner.transaction.size();
+      header.or_threshold = or_threshold;
+      header.rr_threshold = rr_threshold;
+      header.arr_threshold = arr_threshold;
+      header.p_value = p_val;
+      header.min_case_out = min_case_out;
+      header.max_control = max_control;
+      if(lattice.write(lattice_output, header)) cout<<"#saved patterns: "<<lattice_output<<endl;
+      else cout<<"#error: cannot write "<<lattice_output<<endl;
+    }
+  mine_timer.stop();
+  mine_perf.stop();
+  if(progress_interval!=0) stop_progress();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  cout<<"#running time "<<std::chrono::duration<float>(end-begin).count()<<" s"<<endl;
 
   /////////////////////////////////////
 
@@ -0,0 +1,74 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef CANCEL_HPP_
+#define CANCEL_HPP_
+
+#include <atomic>
+
+#include "memory.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////CANCELLATION OF A SEARCH///////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+A CancelToken can be cancelled from any thread. The search of a thread
+checks the token installed by a CancelScope at each node and returns
+without visiting the rest of the tree. All searches stop when the memory
+limit is reached.
+ */
+struct CancelToken
+{
+  std::atomic<bool> flag;
+
+  CancelToken() : flag(false) {}
+  void cancel() { flag.store(true, std::memory_order_relaxed); }
+  bool cancelled() const { return flag.load(std::memory_order_relaxed); }
+};
+
+extern thread_local const CancelToken* search_token;
+
+//true if the search of the calling thread is cancelled
+inline bool search_cancelled()
+{
+  return (search_token && search_token->cancelled()) || memory_exhausted.load(std::memory_order_relaxed);
+}
+
+//install a token for the search of the calling thread until the end of the scope
+struct CancelScope
+{
+  const CancelToken* previous;
+  CancelScope(const CancelToken* token) : previous(search_token) { search_token = token; }
+  ~CancelScope() { search_token = previous; }
+};
+
+#endif /* CANCEL_HPP_ */
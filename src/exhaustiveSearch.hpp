@@ -44,6 +44,7 @@
 #include <stdlib.h>
 
 #include "expand_avx.hpp"
+#include "significance.hpp"
 #include "utils.hpp"
 
 using namespace std;
@@ -51,8 +52,8 @@ using namespace std;
 /////////////////////////////////////////////////////////////////////////////
 //////////////EXHAUTIVE: FIND ALL STATISTICAL SIGNIFICANT PATTERNS///////////
 ////////////////////////////////////////////////////////////////////////////
-void print_itemset_score_exh(Tidset_vector& p, Transaction& att, float& or_threshold, float& rr_threshold, float & arr_threshold);
-void expand_control_exh(Tidset_vector p, int e, float& or_threshold, float& rr_threshold, float& arr_threshold, int min_case_out, int& nb_patterns, Transaction& att, int nb_registers, int& nb_pruning_control);
-void expand_case_exh(Tidset_vector p, int e, float& or_threshold, float& rr_threshold,float& arr_threshold, int min_case_out, int& nb_patterns, int& nb_pruning_case, Transaction& att, int nb_registers, int& nb_pruning_control);
+void report_pattern_exh(Tidlist& tid, Tidset_vector& p, Transaction& att, Significance& sig, const PatternSink& sink);
+void expand_control_exh(Tidset_vector p, int e, float& or_threshold, float& rr_threshold, float& arr_threshold, float& p_threshold, Significance& sig, const PatternSink& sink, int min_case_out, int& nb_patterns, Transaction& att, int nb_registers, int& nb_pruning_control);
+void expand_case_exh(Tidset_vector p, int e, float& or_threshold, float& rr_threshold,float& arr_threshold, float& p_threshold, Significance& sig, const PatternSink& sink, int min_case_out, int& nb_patterns, int& nb_pruning_case, Transaction& att, int nb_registers, int& nb_pruning_control);
 
 #endif /* EXHAUSTIVESEARCH_HPP_ */
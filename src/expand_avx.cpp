@@ -37,9 +37,13 @@
 #include <iostream>
 #include <vector>
 #include <bitset>
+#include <algorithm>
 
 #include "expand_avx.hpp"
 #include "utils.hpp"
+#include "stats.hpp"
+#include "perf.hpp"
+#include "parallel.hpp"
 
 
 using namespace std;
@@ -56,86 +60,108 @@ int popcount(int v)
     return ((v + (v >> 4) & 0xF0F0F0F) * 0x1010101) >> 24;
  }
 
-//return the size of an Tidset = number of bits 1 in an tidset
-int get_size(Tidset_vector& a)
+//return the number of bits 1 in the registers [begin, end) of an tidset
+int popcount_range(Tidset_vector& a, int begin, int end)
 {
   int result = 0;
-  for(int i=0; i<a.size();i++){
-      int* f = (int*)&a[i];
-      for(int j=0; j<nb_chunks; j++)
-    	  result += popcount(f[j]);
-    }
+  for(int i=begin; i<end; i++)
+    result += _mm_popcnt_u64(_mm256_extract_epi64(a[i],0)) + _mm_popcnt_u64(_mm256_extract_epi64(a[i],1))
+            + _mm_popcnt_u64(_mm256_extract_epi64(a[i],2)) + _mm_popcnt_u64(_mm256_extract_epi64(a[i],3));
   return result;
 }
 
+//return the size of an Tidset = number of bits 1 in an tidset
+int get_size(Tidset_vector& a)
+{
+  return popcount_range(a, 0, a.size());
+}
+
+//return the number of case tids in an tidset
+int get_case_size(Tidset_vector& a, Transaction& att)
+{
+  return popcount_range(a, 0, att.case_registers);
+}
+
+//count the case tids (a) and control tids (c) of an tidset
+void get_support(Tidset_vector& a, Transaction& att, int& nb_case_tids, int& nb_control_tids)
+{
+  nb_case_tids = popcount_range(a, 0, att.case_registers);
+  nb_control_tids = popcount_range(a, att.case_registers, a.size());
+}
+
+//return the bit position of tid e: cases from bit 0, controls from register case_registers
+int tid_position(int e, Transaction& att)
+{
+  if(e < att.nb_case) return e;
+  return att.case_registers*nb_bits + (e - att.nb_case);
+}
+
+//return the tid stored at a bit position
+int position_tid(int pos, Transaction& att)
+{
+  if(pos < att.case_registers*nb_bits) return pos;
+  return pos - att.case_registers*nb_bits + att.nb_case;
+}
+
 //set a value (0 or 1) at a position of tidset
 void SetBit(Tidset & vector, size_t position, bool value)
 {
   //    assert(position <= 255);
+  //select the 64-bit lane of the position and put the bit into it
+  __m256i lane = _mm256_cmpeq_epi64(_mm256_set_epi64x(3,2,1,0), _mm256_set1_epi64x(position >> 6));
+  __m256i mask = _mm256_and_si256(lane, _mm256_set1_epi64x(1ULL << (position & 63)));
+  if (value)
+    vector = _mm256_or_si256(mask, vector);
+  else
+    vector = _mm256_andnot_si256(mask, vector);
+}
 
-    uint8_t lut[32] = { 0 };
-    lut[position >> 3] = 1 << (position & 7);
-    __m256i mask = _mm256_loadu_si256((__m256i*)lut);
-    if (value)
-        vector = _mm256_or_si256(mask, vector);
-    else
-        vector = _mm256_andnot_si256(mask, vector);
+//add tid e to an tidset
+void set_tid(Tidset_vector& a, int e, Transaction& att)
+{
+  int pos = tid_position(e, att);
+  SetBit(a[pos/nb_bits], pos%nb_bits, true);
 }
 
 //check tidset empty? return 1: empty; 0: not empty
 int check_empty_avx (Tidset_vector& a)
 {
-  int check = 1;
-  for(int i=0; i<a.size(); i++){
-      int* f = (int*)&a[i];
-      for(int l=0; l<nb_chunks; l++)
-    	  if (f[l]!=0){
-    		  check = 0;
-    		  break;
-    	  }
-    	}
-  return check;
+  for(int i=0; i<a.size(); i++)
+    if(!_mm256_testz_si256(a[i], a[i]))
+      return 0;
+  return 1;
 }
 
 
 //return minimal tid of an tidset  = find the first position of tidset that is set by 1
 int min_tidset_avx(Tidset_vector& a, Transaction& att)
 {
-  int pos = 0;
+  unsigned long long f[4];
   for(int i=0; i<a.size(); i++){
-      int* f = (int*)&a[i];
-      for(int l=0; l<nb_chunks; l++){
-    	  for(int x=0; x<32; x++) {
-    		  int bit = (f[l] >> x) & 1;
-    		  if(bit) return att.nb_sample - (a.size()*256-pos);
-    		  else pos++;
-    	  }
-      }
+      _mm256_storeu_si256((__m256i*)f, a[i]);
+      for(int l=0; l<4; l++)
+    	  if(f[l]) return position_tid(i*nb_bits + l*64 + __builtin_ctzll(f[l]), att);
     }
-	return pos;
+  return -1;
 }
 
 //return maximal tid of an tidset = find the last position of tidset that is set by 1
 int max_tidset_avx(Tidset_vector& a,Transaction& att)
 {
-  int pos = att.nb_sample-1;
-  for(int i=a.size()-1; i>=0; i++){
-      int* f = (int*)&a[i];
-      for(int l=nb_chunks-1; l>=0; l--)	{
-    	  for(int x=31; x>=0; x--) {
-    		  int bit = (f[l] >> x) & 1;
-    		  if(bit) return pos;
-    		  else pos--;
-    	  }
-      }
+  unsigned long long f[4];
+  for(int i=a.size()-1; i>=0; i--){
+      _mm256_storeu_si256((__m256i*)f, a[i]);
+      for(int l=3; l>=0; l--)
+    	  if(f[l]) return position_tid(i*nb_bits + l*64 + 63 - __builtin_clzll(f[l]), att);
     }
-	return pos;
+  return -1;
 }
 
 //compute intersection of two tidset
 Tidset_vector add_tidset_avx(Tidset_vector& a, Tidset_vector& b)
 {
   Tidset_vector tmp;
+  tmp.reserve(a.size());
   for(int i=0; i<a.size();i++)
     tmp.push_back(_mm256_or_si256(a[i],b[i]));
   return tmp;
@@ -145,6 +171,7 @@ Tidset_vector add_tidset_avx(Tidset_vector& a, Tidset_vector& b)
 Tidset_vector remove_tidset_avx(Tidset_vector& a, Tidset_vector& b)
 {
   Tidset_vector tmp;
+  tmp.reserve(a.size());
   for(int i=0; i<a.size();i++)
     tmp.push_back(_mm256_xor_si256(a[i],b[i]));
   return tmp;
@@ -152,156 +179,287 @@ Tidset_vector remove_tidset_avx(Tidset_vector& a, Tidset_vector& b)
 
 
 //find the positions which are set by 1 in an tidset = list of transaction ids
-std::vector<int> get_bitset_pos(Tidset_vector& a, Transaction& att)
+Poslist get_bitset_pos(Tidset_vector& a, Transaction& att)
 {
-  std::vector<int> result;
-  int pos = a.size()*256;
+  Poslist result;
+  unsigned long long f[4];
   for(int i=0; i<a.size(); i++)
     {
-      int* f = (int*)&a[i];
-      for(int l=0; l<nb_chunks; l++)
+      _mm256_storeu_si256((__m256i*)f, a[i]);
+      for(int l=0; l<4; l++)
 	{
-	  for(int x=0; x<32; x++) {
-	    int bit = (f[l] >> x) & 1;
-	    if(bit) {result.push_back(att.nb_sample-pos); pos--;}
-	    else pos--;
+	  unsigned long long w = f[l];
+	  while(w) {
+	    result.push_back(position_tid(i*nb_bits + l*64 + __builtin_ctzll(w), att));
+	    w &= w-1;
 	  }
 	}
     }
   return result;
 }
 
+Poslist get_rows_pos(const std::vector<int>& rows, Transaction& att)
+{
+  Tidset_vector p(att.case_registers + att.control_registers);
+  for(int i=0; i<p.size(); i++) p[i] = _mm256_or_si256(att.case_itemset[i], att.control_itemset[i]);
+  for(int r=0; r<rows.size(); r++)
+    for(int i=0; i<p.size(); i++) p[i] = _mm256_and_si256(p[i], att[rows[r]][i]);
+  return get_bitset_pos(p, att);
+}
+
+//return the original ids (labels) of the items in a tidlist in increasing order
+//items may be reordered at loading time, the labels restore the ids of the input file
+std::vector<int> get_labels(Tidlist& tid, Transaction& att)
+{
+  std::vector<int> result;
+  for(int i=0; i<tid.size(); i++)
+    result.push_back(att.tidset[tid[i]].label);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+//return the largest support of the items in a tidlist
+//it bounds the support of any itemset made of these items
+int max_item_support(Tidlist& tid, Transaction& att)
+{
+  int result = 0;
+  for(int i=0; i<tid.size(); i++)
+    result = std::max(result, att.tidset[tid[i]].support);
+  return result;
+}
+
 ////////////////////////////////
 void print_itemset(Tidset_vector& a, Transaction& att)
 {
-  int n = a.size()*256-att.nb_sample;
-  int count = 0;
+  Poslist pos = get_bitset_pos(a, att);
   // cout<<"(";
-  for(int i=0; i<a.size(); i++)
-    {
-      int* f = (int*)&a[i];
-      for(int l=0; l<nb_chunks; l++)
-	{
-	  for(int x=0; x<32; x++) 
-	    {
-	      int bit = (f[l] >> x) & 1;
-	      if(bit) cout<<count-n<<" ";
-	      count++;
-	    }
-	}
-    }
+  for(int i=0; i<pos.size(); i++)
+    cout<<pos[i]<<" ";
   //  cout<<")";
 }
 
-//compute intersection of two tidsets
-Tidlist compute_tidlist_avx(Tidset_vector& p, Transaction& att)
+//store in regs the registers of [begin, end) of an tidset that are not empty, return their number
+//(deep in the search a tidset holds few tids: its other registers need no test)
+int nonempty_registers(Tidset_vector& a, int begin, int end, int* regs)
 {
-  Tidlist tid;
-  // #pragma omp parallel for num_threads(nb_threads)
-  for(int i=0; i<att.tidset.size(); i++)
+  int n = 0;
+  for(int i=begin; i<end; i++)
+    if(!_mm256_testz_si256(a[i], a[i])) regs[n++] = i;
+  return n;
+}
+
+//OR of the 32-bit words of an tidset: a tidset is a subset of another only if
+//its signature is a subset of the signature of the other
+unsigned int tidset_signature(Tidset_vector& a)
+{
+  __m256i fold = _mm256_setzero_si256();
+  for(int i=0; i<a.size(); i++) fold = _mm256_or_si256(fold, a[i]);
+  unsigned long long f = _mm256_extract_epi64(fold,0) | _mm256_extract_epi64(fold,1) | _mm256_extract_epi64(fold,2) | _mm256_extract_epi64(fold,3);
+  return (unsigned int)f | (unsigned int)(f >> 32);
+}
+
+//add to tid the items of [begin, end) containing p, tested on the registers regs of p
+template <typename List>
+static void tidlist_range(Tidset_vector& p, Transaction& att, int* regs, int nb_regs, unsigned int signature, int begin, int end, List& tid)
+{
+  for(int i=begin; i<end; i++)
     {
+      if(signature & ~att.tidset[i].signature) continue;
       //if( _mm256_testc_si256(_mm256_loadu_si256(&att[i][0]) , p ) ) tid.push_back(i);
-      int founded[p.size()];
-      for(int j=0; j<p.size(); j++)
-	//founded[j] = _mm256_testc_si256(_mm256_loadu_si256(&att[i][j]) , p ); //px[j] is subset of att[][] ???
-	founded[j] = _mm256_testc_si256(att[i][j], p[j] ); //px[j] is subset of att[][] ???
       bool found = true;
-      for(int k=0; k<p.size(); k++) if(founded[k]==0) { found=false; break;}
+      for(int k=0; k<nb_regs; k++)
+	if(!_mm256_testc_si256(att[i][regs[k]], p[regs[k]])) { found=false; break;} //px[j] is subset of att[][] ???
       if(found) tid.push_back(i);
      }   
+}
+
+//compute intersection of two tidsets
+Tidlist compute_tidlist_avx(Tidset_vector& p, Transaction& att)
+{
+  PerfScope perf(PERF_TIDLIST);
+  thread_stats().nb_tidlist++;
+  Tidlist tid;
+  tid.reserve(att.size());
+  //p is a subset of an item if its non-empty registers are
+  int regs[p.size()];
+  int nb_regs = nonempty_registers(p, 0, p.size(), regs);
+  //an item missing a bit of the signature of p cannot contain p, its registers are not read
+  //(with one or two registers to test, testing them costs no more than the signature)
+  unsigned int signature = (nb_regs > 2) ? tidset_signature(p) : 0;
+  int nb_items = att.size();
+  int nb_parts = kernel_parts((long)nb_items*nb_regs);
+  if(nb_parts > 1){
+      //each part of the items in its own tidlist, appended in order
+      std::vector<std::vector<int> > partial(nb_parts);
+      if(run_parts(nb_parts, [&](int part){
+	    tidlist_range(p, att, regs, nb_regs, signature, (long)nb_items*part/nb_parts, (long)nb_items*(part+1)/nb_parts, partial[part]);
+	  })){
+	  for(int k=0; k<nb_parts; k++) tid.insert(tid.end(), partial[k].begin(), partial[k].end());
+	  return tid;
+	}
+    }
+  tidlist_range(p, att, regs, nb_regs, signature, 0, nb_items, tid);
   return tid;
 }
 
+//intersect result with the items tid[begin..end), on its registers regs
+//only the registers that are not empty yet are intersected, an empty register stays empty
+static void closure_range(Tidset_vector& result, Tidlist& tid, Transaction& att, int* regs, int nb_regs, int begin, int end)
+{
+  int active[nb_regs];
+  std::copy(regs, regs+nb_regs, active);
+  for(int i=begin; (i<end) && (nb_regs>0); i++)
+    {
+      int n = 0;
+      for(int k=0; k<nb_regs; k++)
+	{
+	  int j = active[k];
+	  result[j] = _mm256_and_si256(result[j] , att[tid[i]][j]) ;
+	  if(!_mm256_testz_si256(result[j], result[j])) active[n++] = j;
+	}
+      nb_regs = n;
+    }
+}
+
 //compute closure of an tidset
 Tidset_vector compute_closure_avx(Tidlist tid, Transaction& att, int nb_registers, int option)
 //option: 0 - case, 1 - control, 2 - all data
 {
+  PerfScope perf(PERF_CLOSURE);
+  thread_stats().nb_closure++;
+  //registers kept: case registers only (0), control registers only (1), all (2)
+  int begin = (option == 1) ? att.case_registers : 0;
+  int end = (option == 0) ? att.case_registers : nb_registers;
+
   //compute intersection
   Tidset_vector result;
-  for(int i=0; i<nb_registers; i++) result.push_back(att[tid[0]][i]);
-
-  for(int i=1; i<tid.size(); i++)
-    for(int j=0; j<nb_registers; j++)
-      {
-	result[j] = _mm256_and_si256(result[j] , att[tid[i]][j]) ;
-      }
- 
-  int n = nb_registers*256;
-  switch (option)
-    {
-    case 0:
-      for(int i=(n-1); i>= (n-att.nb_control); i--)
-	{
-	  int v = i/256;
-	  int pos = i%256;
-	  SetBit(result[v], pos, 0);
-	}
-      return result;
-      break;
+  result.reserve(nb_registers);
+  for(int i=0; i<nb_registers; i++) result.push_back( (i>=begin && i<end) ? att[tid[0]][i] : _mm256_setzero_si256() );
 
-    case 1:
-      for(int i=(n-att.nb_control-1); i>= (n-att.nb_sample); i--)
-	{
-	  int v = i/256;
-	  int pos = i%256;
-	  SetBit(result[v], pos, 0);
+  int regs[nb_registers];
+  int nb_regs = nonempty_registers(result, begin, end, regs);
+  int nb_items = tid.size();
+  int nb_parts = kernel_parts((long)(nb_items-1)*nb_regs);
+  if(nb_parts > 1){
+      //each part of the items intersected in its own tidset, the partial tidsets are intersected at the end
+      std::vector<Tidset_vector> partial(nb_parts, result);
+      if(run_parts(nb_parts, [&](int part){
+	    closure_range(partial[part], tid, att, regs, nb_regs, 1 + (long)(nb_items-1)*part/nb_parts, 1 + (long)(nb_items-1)*(part+1)/nb_parts);
+	  })){
+	  for(int k=0; k<nb_regs; k++)
+	    for(int part=0; part<nb_parts; part++)
+	      result[regs[k]] = _mm256_and_si256(result[regs[k]], partial[part][regs[k]]);
+	  return result;
 	}
-      return result;
-      break;
-
-    case 2:
-      return result;
-      break;
     }
-
+  closure_range(result, tid, att, regs, nb_regs, 1, nb_items);
   return result;
 }
 
 //reduce dataset att with regard to a given tidset
 Transaction reduced_dataset_avx(Tidlist tid, Transaction& att)
 {
+  PerfScope perf(PERF_REDUCED);
+  Stats& stats = thread_stats();
+  stats.nb_reduced++;
+  stats.reduced_items += tid.size();
+  stats.max_reduced_items = std::max(stats.max_reduced_items, (long)tid.size());
   Transaction dtt;
+  dtt.reserve(tid.size());
+  dtt.tidset.reserve(tid.size());
   for(int i=0; i< tid.size();i++)
     {
       dtt.push_back(att[tid[i]]);
       ITEM tid_tmp;
       tid_tmp.id = i;
       tid_tmp.label = att.tidset[tid[i]].label;
+      tid_tmp.support = att.tidset[tid[i]].support;
+      tid_tmp.signature = att.tidset[tid[i]].signature;
       dtt.tidset.push_back(tid_tmp);
     }
   dtt.nb_sample = att.nb_sample;
   dtt.nb_case = att.nb_case;
   dtt.nb_control = att.nb_control;
+  dtt.case_registers = att.case_registers;
+  dtt.control_registers = att.control_registers;
   dtt.case_itemset = att.case_itemset;
   dtt.control_itemset = att.control_itemset;
 
   return dtt;
 }
 
+//dataset of the children of a node whose items are tid: the reduced dataset in ratt,
+//or att itself when the memory is short (the children only use the items containing
+//their tidset, which are the same in both)
+Transaction& project_dataset_avx(Tidlist& tid, Transaction& att, Transaction& ratt)
+{
+  if(memory_tight()) return att;
+  ratt = reduced_dataset_avx(tid, att);
+  return ratt;
+}
+
+//copy a dataset where all tids belong to the 1st class (tid i at bit i)
+//the search then enumerates the closed tidsets without regard to the classes
+Transaction merge_classes_avx(Transaction& att)
+{
+  Transaction dtt;
+  int nb_registers = (att.nb_sample + nb_bits - 1)/nb_bits;
+  for(int i=0; i<att.size(); i++)
+    {
+      Tidset_vector row(nb_registers, _mm256_setzero_si256());
+      Poslist pos = get_bitset_pos(att[i], att);
+      for(int j=0; j<pos.size(); j++)
+	SetBit(row[pos[j]/nb_bits], pos[j]%nb_bits, true);
+      dtt.push_back(row);
+      dtt.tidset.push_back(att.tidset[i]);
+      dtt.tidset.back().signature = tidset_signature(row);
+    }
+  dtt.nb_sample = att.nb_sample;
+  dtt.nb_case = att.nb_sample;
+  dtt.nb_control = 0;
+  dtt.case_registers = nb_registers;
+  dtt.control_registers = 0;
+  dtt.case_itemset = Tidset_vector(nb_registers, _mm256_setzero_si256());
+  for(int i=0; i<att.nb_sample; i++)
+    SetBit(dtt.case_itemset[i/nb_bits], i%nb_bits, true);
+  dtt.control_itemset = Tidset_vector(nb_registers, _mm256_setzero_si256());
+
+  return dtt;
+}
+
+//copy a dataset where the tidset of each item is restricted to mask
+//(the closed patterns of the copy are those of att whose tidset is inside mask)
+Transaction masked_dataset_avx(Transaction& att, Tidset_vector& mask)
+{
+  Transaction dtt;
+  for(int i=0; i<att.size(); i++)
+    {
+      Tidset_vector row(mask.size());
+      for(int j=0; j<mask.size(); j++)
+	row[j] = _mm256_and_si256(att[i][j], mask[j]);
+      dtt.push_back(row);
+      ITEM tid_tmp = att.tidset[i];
+      tid_tmp.support = get_size(row);
+      tid_tmp.signature = tidset_signature(row);
+      dtt.tidset.push_back(tid_tmp);
+    }
+  dtt.nb_sample = att.nb_sample;
+  dtt.nb_case = att.nb_case;
+  dtt.nb_control = att.nb_control;
+  dtt.case_registers = att.case_registers;
+  dtt.control_registers = att.control_registers;
+  dtt.case_itemset = att.case_itemset;
+  dtt.control_itemset = att.control_itemset;
+  return dtt;
+}
+
 //heuristic: predict expanding based on odds ratio
 int predict_expand_avx(Tidlist tid, float threshold, Transaction& att, int nb_registers )
 {
   int nb_case_ext = 0;
   int nb_control_ext = 0;
   Tidset_vector p_ext_all = compute_closure_avx(tid,att,nb_registers,2);
-
-  int n =  nb_registers*256;
-  int count = nb_registers*256-1;
-  for(int i=nb_registers-1; i>=0; i--)
-    {
-      int* f = (int*)&p_ext_all[i];
-      for(int l=nb_chunks-1; l>=0; l--)
-	{
-	  for(int k=31; k>=0; k--) 
-	    {
-	      if( f[l]&(1<<k) ){
-			  if(count >= n-att.nb_control ){ nb_control_ext++;}
-				else if(count >= n-att.nb_sample ) {nb_case_ext++;}
-		}
-	      count--;	      
-	    }
-	}
-    }
+  get_support(p_ext_all, att, nb_case_ext, nb_control_ext);
   //cout<<nb_case_ext<<" "<<nb_control_ext<<endl;
   //  cout<<"# case "<<nb_case_ext<<"; # control "<<nb_control_ext<<endl;
   int p_ext_control_size = (threshold*nb_control_ext*att.nb_case) / (nb_control_ext*(threshold-1) + att.nb_control);
@@ -309,29 +467,27 @@ int predict_expand_avx(Tidlist tid, float threshold, Transaction& att, int nb_re
 }
 
 //check discriminative scores of an itemset ~ pruning
-int check_itemset_score(Tidset_vector& p, Transaction& att, float or_threshold, float rr_threshold, float arr_threshold, int min_case_out)
+int check_itemset_score(Tidset_vector& p, Transaction& att, float or_threshold, float rr_threshold, float arr_threshold, float p_threshold, int min_case_out)
 {
+  PerfScope perf(PERF_SCORE);
   int a = 0;
   int c = 0;
-  int count = p.size()*256;
-  for(int i=0; i<p.size(); i++){
-      int* f = (int*)&p[i];
-      for(int l=0; l<nb_chunks; l++){
-    	  for(int k=0;k<32;k++){
-    		  if( f[l]&(1<<k) ){ //check if the value at position k of f[l] is set 1
-    			  if(count <= att.nb_control ){ c++;}
-    			  else if(count <= att.nb_sample ) {a++;}
-    		  }
-	      count--;
-    	  }
-      }
-  }
+  get_support(p, att, a, c);
+  return check_support_score(a, c, att.nb_case, att.nb_control, or_threshold, rr_threshold, arr_threshold, p_threshold, min_case_out);
+}
+
+//check discriminative scores of a pattern covering a cases and c controls
+int check_support_score(int a, int c, int nb_case, int nb_control, float or_threshold, float rr_threshold, float arr_threshold, float p_threshold, int min_case_out)
+{
+  //p-value threshold: O(1) lookup in the table of Fisher's exact test
+  if( (p_threshold != 0) && (fisher_pvalue(a,c) > p_threshold) )
+    return false;
 
   //cout<<a<<","<<c<<endl;
   //c > 0:  exist tids in the control group
   if(c > 0){
-      int b = att.nb_case - a;
-      int d = att.nb_control - c;
+      int b = nb_case - a;
+      int d = nb_control - c;
       float odd = odd_ratio(a,b,c,d);
       float rr = risk_ratio(a,b,c,d);
       float arr = difference_risk(a,b,c,d);
@@ -354,3 +510,14 @@ int check_itemset_score(Tidset_vector& p, Transaction& att, float or_threshold,
     	else
     		return false;
 }
+
+//check p-value of an itemset, always true when no p-value threshold is used
+int check_itemset_pvalue(Tidset_vector& p, Transaction& att, float p_threshold)
+{
+  if(p_threshold == 0) return true;
+  PerfScope perf(PERF_SCORE);
+  int a = 0;
+  int c = 0;
+  get_support(p, att, a, c);
+  return fisher_pvalue(a,c) <= p_threshold;
+}
@@ -41,9 +41,11 @@
 #include <iostream>
 #include <vector>
 #include <bitset>
+#include <functional>
 #include <stdlib.h>
 
 #include "utils.hpp"
+#include "memory.hpp"
 
 using namespace std;
 
@@ -96,11 +98,12 @@ class aligned_allocator
 			return !(*this == other);
 		}
  
-		void construct(T * const p, const T& t) const
+		template <typename U, typename... Args>
+		void construct(U * const p, Args&&... args) const
 		{
 			void * const pv = static_cast<void *>(p);
  
-			new (pv) T(t);
+			new (pv) U(std::forward<Args>(args)...);
 		}
  
 		void destroy(T * const p) const
@@ -149,6 +152,12 @@ class aligned_allocator
 			  //throw std::cout("aligned_allocator<T>::allocate() - Integer overflow.");
 			}
  
+			// The temporaries of a node of the search come from the arena of the thread.
+			if (thread_arena.frames)
+			{
+				return static_cast<T *>(arena_allocate(n * sizeof(T)));
+			}
+ 
 			// Mallocator wraps malloc().
 			void * const pv = _mm_malloc(n * sizeof(T), Alignment);
  
@@ -158,11 +167,19 @@ class aligned_allocator
 				throw std::bad_alloc();
 			}
  
+			memory_allocated(n * sizeof(T));
 			return static_cast<T *>(pv);
 		}
  
 		void deallocate(T * const p, const std::size_t n) const
 		{
+			// The blocks of the arena are released by their frame.
+			if (arena_owns(p))
+			{
+				arena_free(p, n * sizeof(T));
+				return;
+			}
+			memory_freed(n * sizeof(T));
 			_mm_free(p);
 		}
  
@@ -199,13 +216,16 @@ typedef std::vector<__m256i, aligned_allocator<__m256i, sizeof(__m256i)> > align
 const int nb_bits = 256;//nb of bits per register (AVX2=256bits)
 const int nb_chunks = 8; //nb of integer values per register = 256/32
 
-typedef std::vector<int> Tidlist; //store ids of items in transposition matrix
+typedef std::vector<int, aligned_allocator<int, sizeof(__m256i)> > Tidlist; //store ids of items in transposition matrix
+typedef std::vector<int, aligned_allocator<int, sizeof(__m256i)> > Poslist; //positions of the bits set in a tidset
 
 struct ITEM{
   int id;
   int label;
+  int support; //number of tids containing the item
+  unsigned int signature; //OR of the 32-bit words of the tidset of the item (ITEM stays 16 bytes)
 };
-typedef std::vector<ITEM> Itemset;
+typedef std::vector<ITEM, aligned_allocator<ITEM, sizeof(__m256i)> > Itemset;
 //set of items:
 //each item is a pair of id-label
 //it stores the original ids of an items when using reduced dataset
@@ -216,22 +236,47 @@ typedef aligned_vector Tidset_vector; //tidset of data which have transactions (
 //transposition transaction dataset is a set of vector
 //each vector is an set of tids
 //the size of transtraction table = the number of items
-struct Transaction : std::vector<Tidset_vector> //define data struture
+//
+//layout of a tidset: tids are numbered from the least significant bit.
+//case tids 0..nb_case-1 occupy the registers [0, case_registers),
+//control tids nb_case..nb_sample-1 start at the fresh register case_registers
+//and occupy [case_registers, case_registers+control_registers).
+//A case and a control never share a register, so restricting a tidset to a
+//class is a selection of a register range.
+struct Transaction : std::vector<Tidset_vector, aligned_allocator<Tidset_vector, sizeof(__m256i)> > //define data struture
 {
   int nb_sample;
   int nb_case;
   int nb_control;
+  int case_registers;    //number of registers of the case tids
+  int control_registers; //number of registers of the control tids
   Tidset_vector case_itemset;
   Tidset_vector control_itemset;
   Itemset tidset;
 };
 
+//receives each pattern found by a search: original ids of its items,
+//number of case tids (a) and of control tids (c)
+typedef std::function<void(const std::vector<int>& items, int a, int c)> PatternSink;
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 int popcount(int v);
 
+int popcount_range(Tidset_vector& a, int begin, int end);
+
 int get_size(Tidset_vector& a);
 
+void get_support(Tidset_vector& a, Transaction& att, int& nb_case_tids, int& nb_control_tids);
+
+int tid_position(int e, Transaction& att);
+
+int position_tid(int pos, Transaction& att);
+
+void set_tid(Tidset_vector& a, int e, Transaction& att);
+
+int get_case_size(Tidset_vector& a, Transaction& att);
+
 void SetBit(Tidset & vector, size_t position, bool value);
 
 int check_empty_avx (Tidset_vector& a);
@@ -244,17 +289,34 @@ Tidset_vector add_tidset_avx(Tidset_vector& a, Tidset_vector& b);
 
 Tidset_vector remove_tidset_avx(Tidset_vector& a, Tidset_vector& b);
 
-int check_itemset_score(Tidset_vector& p, Transaction& att, float or_threshold, float rr_threshold, float arr_threshold, int minCase);
+int check_itemset_score(Tidset_vector& p, Transaction& att, float or_threshold, float rr_threshold, float arr_threshold, float p_threshold, int minCase);
+
+int check_support_score(int a, int c, int nb_case, int nb_control, float or_threshold, float rr_threshold, float arr_threshold, float p_threshold, int min_case_out);
+
+int check_itemset_pvalue(Tidset_vector& p, Transaction& att, float p_threshold);
 
-std::vector<int> get_bitset_pos(Tidset_vector& a,  Transaction& att);
+Poslist get_bitset_pos(Tidset_vector& a,  Transaction& att);
+//tids of the samples containing the items of the rows (positions in att)
+Poslist get_rows_pos(const std::vector<int>& rows, Transaction& att);
+
+std::vector<int> get_labels(Tidlist& tid, Transaction& att);
+
+int max_item_support(Tidlist& tid, Transaction& att);
 
 void print_itemset(Tidset_vector& a, Transaction& att);
 
+int nonempty_registers(Tidset_vector& a, int begin, int end, int* regs);
+
+unsigned int tidset_signature(Tidset_vector& a);
+
 Tidlist compute_tidlist_avx(Tidset_vector& p, Transaction& att);
 
 Tidset_vector compute_closure_avx(Tidlist tid, Transaction& att, int nb_registers, int option);
 
 Transaction reduced_dataset_avx(Tidlist tid, Transaction& att);
+Transaction& project_dataset_avx(Tidlist& tid, Transaction& att, Transaction& ratt);
+Transaction merge_classes_avx(Transaction& att);
+Transaction masked_dataset_avx(Transaction& att, Tidset_vector& mask);
 
 int predict_expand_avx(Tidlist tid, float threshold, Transaction& att, int nb_registers );
 
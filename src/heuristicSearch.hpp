@@ -51,8 +51,9 @@ using namespace std;
 ///////////////////////////////////////////////////////////
 ///////HEURISTIC: FIND MAXIMAL STATISTICAL SIGNIFICANT PATTERNS///////
 ///////////////////////////////////////////////////////////
-void print_itemset_score(Tidset_vector& p, Transaction& att, float& or_threshold, float& rr_threshold, float& arr_threshold);
-void expand_control_heu(Tidset_vector p, Tidlist tid, float& or_threshold, float& rr_threshold,float& arr_threshold, int min_case_out, int& nb_patterns, Transaction& att, int nb_registers, int& nb_it);
-void expand_case_heu(Tidset_vector p, int e, float& or_threshold, float& rr_threshold, float& arr_threshold, int min_case_out, int it_threshold,  int& nb_patterns, int& nb_pruning_case, Transaction& att, int nb_registers, int& nb_it);
+void update_threshold_heu(Tidset_vector& p, Transaction& att, float& or_threshold);
+void report_pattern_heu(Tidlist& tid, Tidset_vector& p, Transaction& att, const PatternSink& sink);
+void expand_control_heu(Tidset_vector p, Tidlist tid, float& or_threshold, float& rr_threshold,float& arr_threshold, float& p_threshold, const PatternSink& sink, int min_case_out, int& nb_patterns, Transaction& att, int nb_registers, int& nb_it);
+void expand_case_heu(Tidset_vector p, int e, float& or_threshold, float& rr_threshold, float& arr_threshold, float& p_threshold, const PatternSink& sink, int min_case_out, int it_threshold,  int& nb_patterns, int& nb_pruning_case, Transaction& att, int nb_registers, int& nb_it);
 
 #endif /* HEURISTICSEARCH_HPP_ */
@@ -0,0 +1,212 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "increment.hpp"
+#include "lattice.hpp"
+#include "loader.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+long mine_new_items(Transaction& transaction, int first_label, const MinerConfig& config, const PatternSink& sink)
+{
+  long nb_patterns = 0;
+  for(int r=0; r<transaction.size(); r++){
+      int label = transaction.tidset[r].label;
+      if(label < first_label) continue;
+      //the closed patterns holding item r are those of the dataset restricted to its tidset
+      Transaction masked = masked_dataset_avx(transaction, transaction[r]);
+      Miner miner(std::move(masked), config);
+      miner.mine([&](const std::vector<int>& items, int a, int c){
+	  //a pattern with several new items is output by the search of the smallest one
+	  for(int i=0; i<items.size(); i++)
+	    if((items[i] >= first_label) && (items[i] < label)) return;
+	  nb_patterns++;
+	  sink(items, a, c);
+	});
+    }
+  return nb_patterns;
+}
+
+long keep_saved_patterns(const string& lattice_file, Transaction& transaction, int first_label, const MinerConfig& config, const PatternSink& sink, string& error)
+{
+  LatticeHeader header;
+  if(!read_lattice_header(lattice_file, header, error)) return -1;
+  if((header.nb_case != transaction.nb_case) || (header.nb_control != transaction.nb_control) || (header.nb_items != first_label)){
+      error = lattice_file + " is not a run of the input file";
+      return -1;
+    }
+
+  //row of each selected item in the dataset
+  std::vector<int> rows(first_label, -1);
+  for(int r=0; r<transaction.size(); r++)
+    if(transaction.tidset[r].label < first_label) rows[transaction.tidset[r].label] = r;
+  int nb_registers = transaction.case_registers + transaction.control_registers;
+
+  long nb_patterns = 0;
+  long nb_saved = query_lattice(lattice_file, config, [&](const std::vector<int>& items, int a, int c){
+      Tidlist tid;
+      for(int i=0; i<items.size(); i++)
+	if(rows[items[i]] >= 0) tid.push_back(rows[items[i]]);
+      //a new item containing the tidset of the pattern extends it, the search of the new items outputs it
+      Tidset_vector p = compute_closure_avx(tid, transaction, nb_registers, 2);
+      Tidlist extension = compute_tidlist_avx(p, transaction);
+      for(int i=0; i<extension.size(); i++)
+	if(transaction.tidset[extension[i]].label >= first_label) return;
+      nb_patterns++;
+      sink(items, a, c);
+    }, header, error);
+  if(nb_saved < 0) return -1;
+  return nb_patterns;
+}
+
+int run_increment(const string& lattice_file, const string& input_file, const string& delta_file, int delta_samples, MinerConfig config,
+		  int case_order, int item_order, const string& input_output, const string& lattice_output)
+{
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  int nb_case = 0;
+  int nb_control = 0;
+  int delta_case = 0;
+  int delta_control = 0;
+  std::vector<string> matrix;
+  std::vector<string> delta;
+  if(!read_header(input_file, nb_case, nb_control) || !read_matrix(input_file, matrix)){
+      cout<<"#error: cannot read "<<input_file<<endl;
+      return 1;
+    }
+  if(!read_header(delta_file, delta_case, delta_control) || !read_matrix(delta_file, delta)){
+      cout<<"#error: cannot read "<<delta_file<<endl;
+      return 1;
+    }
+  if((config.method != 0) || (config.lamp_alpha != 0) || (config.wy_alpha != 0)){
+      cout<<"#error: -heuristics, -lamp and -wy are not mined incrementally"<<endl;
+      return 1;
+    }
+  if(!delta_samples && lattice_file.empty()){
+      cout<<"#error: new items need the patterns of the previous run (-lattice)"<<endl;
+      return 1;
+    }
+
+  //update the matrix
+  int nb_items = matrix.size();
+  if(!delta_samples){
+      if((delta_case != nb_case) || (delta_control != nb_control)){
+	  cout<<"#error: the new items must have the samples of "<<input_file<<endl;
+	  return 1;
+	}
+      matrix.insert(matrix.end(), delta.begin(), delta.end());
+    } else {
+      if(delta.size() != matrix.size()){
+	  cout<<"#error: "<<delta_file<<" must have one line of new samples per item"<<endl;
+	  return 1;
+	}
+      for(int r=0; r<matrix.size(); r++){
+	  string line = matrix[r];
+	  line.resize(nb_case+nb_control, '0');
+	  delta[r].resize(delta_case+delta_control, '0');
+	  matrix[r] = line.substr(0, nb_case) + delta[r].substr(0, delta_case) + line.substr(nb_case) + delta[r].substr(delta_case);
+	}
+      //the supports of -min and -max are percents of the classes
+      config.min_case = (config.min_case/nb_case)*(nb_case+delta_case);
+      config.min_case_out = (config.min_case_out/nb_case)*(nb_case+delta_case);
+      config.max_control = (config.max_control/nb_control)*(nb_control+delta_control);
+      nb_case += delta_case;
+      nb_control += delta_control;
+    }
+  if(!input_output.empty()){
+      ofstream out(input_output.c_str(), ofstream::out);
+      out<<"# "<<nb_case<<" "<<nb_control<<"\n";
+      for(int r=0; r<matrix.size(); r++) out<<matrix[r]<<"\n";
+      if(!out){
+	  cout<<"#error: cannot write "<<input_output<<endl;
+	  return 1;
+	}
+    }
+  Transaction transaction = build_transaction(matrix, nb_case, nb_control, config.min_case, config.max_control, case_order, item_order);
+  int nb_selected = transaction.size();
+  std::shared_ptr<const FisherTable> fisher = get_fisher_table(nb_case, nb_control);
+  FisherScope tables(*fisher);
+
+  if(delta_samples) cout<<"#Incremental mining of "<<delta_case<<" + "<<delta_control<<" new samples (full search)"<<endl;
+  else cout<<"#Incremental mining of "<<delta.size()<<" new items"<<endl;
+  cout<<"#size of data: "<<matrix.size()<<" x "<<transaction.nb_sample<<endl;
+  cout<<"#size of reduced data: "<<nb_selected<<" x "<<transaction.nb_sample<<endl;
+  cout<<"#risk thresholds (OR, GR, DS): "<<config.or_threshold<<", "<<config.rr_threshold<<", "<<config.arr_threshold<<endl;
+  if(config.p_value!=0) cout<<"#p_value_threshold: "<<config.p_value<<endl;
+  cout<<"#min case support: "<<(config.min_case/nb_case)*100<<"%"<<endl;
+  cout<<"#max control support: "<<(config.max_control/nb_control)*100<<"%"<<endl;
+  cout<<"#min case output: "<<(config.min_case_out/nb_case)*100<<"%"<<endl;
+  cout<<endl<<"Output:"<<endl;
+  if(config.p_value!=0) cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) : p-value )"<<endl;
+  else cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
+
+  LatticeWriter lattice;
+  PatternSink sink = [&](const std::vector<int>& items, int a, int c){
+    print_pattern(cout, items, a, c, nb_case, nb_control, config.p_value, 0);
+    if(!lattice_output.empty()) lattice.add(items, a, c);
+  };
+  long nb_patterns = 0;
+  if(delta_samples){
+      Miner miner(std::move(transaction), config);
+      nb_patterns = miner.mine(sink);
+    } else {
+      string error;
+      long nb_saved = keep_saved_patterns(lattice_file, transaction, nb_items, config, sink, error);
+      if(nb_saved < 0){
+	  cout<<"#error: "<<error<<endl;
+	  return 1;
+	}
+      nb_patterns = nb_saved + mine_new_items(transaction, nb_items, config, sink);
+    }
+  cout<<endl<<"#nb_patterns "<<nb_patterns<<endl;
+
+  if(!lattice_output.empty()){
+      LatticeHeader header;
+      header.nb_case = nb_case;
+      header.nb_control = nb_control;
+      header.nb_items = matrix.size();
+      header.nb_selected = nb_selected;
+      header.or_threshold = config.or_threshold;
+      header.rr_threshold = config.rr_threshold;
+      header.arr_threshold = config.arr_threshold;
+      header.p_value = config.p_value;
+      header.min_case_out = config.min_case_out;
+      header.max_control = config.max_control;
+      if(lattice.write(lattice_output, header)) cout<<"#saved patterns: "<<lattice_output<<endl;
+      else cout<<"#error: cannot write "<<lattice_output<<endl;
+    }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  cout<<"#running time "<<std::chrono::duration<float>(end-begin).count()<<" s"<<endl;
+  return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef INCREMENT_HPP_
+#define INCREMENT_HPP_
+
+#include <string>
+
+#include "expand_avx.hpp"
+#include "miner.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////INCREMENTAL MINING/////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+New items (delta file of item lines with the samples of the input file):
+a tidset closed before stays closed with the same supports, so the saved
+patterns of -save-lattice are kept, unless a new item contains their
+tidset. The other patterns hold a new item j: they are the closed patterns
+whose tidset is inside the tidset of j, found by a search on the dataset
+masked by the tidset of j. A pattern with several new items is output by
+the search of the smallest one.
+
+New samples (delta file with one line of new cases then new controls per
+item): the sizes of the classes, hence all scores, change, so the merged
+matrix is mined again.
+ */
+
+//mine the closed patterns holding an item whose label is at least first_label
+long mine_new_items(Transaction& transaction, int first_label, const MinerConfig& config, const PatternSink& sink);
+
+//send the saved patterns of lattice_file that no new item extends to sink, -1 and error on failure
+long keep_saved_patterns(const string& lattice_file, Transaction& transaction, int first_label, const MinerConfig& config, const PatternSink& sink, string& error);
+
+//mine input_file with the delta of new items (delta_samples = 0) or samples, print the patterns like a run
+//the updated matrix is written to input_output and the patterns to lattice_output if they are not empty
+int run_increment(const string& lattice_file, const string& input_file, const string& delta_file, int delta_samples, MinerConfig config,
+		  int case_order, int item_order, const string& input_output, const string& lattice_output);
+
+#endif /* INCREMENT_HPP_ */
@@ -0,0 +1,182 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "lattice.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+static const char lattice_magic[8] = {'S','S','D','P','S','L','A','T'};
+static const int lattice_version = 1;
+
+static void put_varint(string& out, unsigned int v)
+{
+  while(v >= 0x80){
+      out.push_back((char)(v | 0x80));
+      v >>= 7;
+    }
+  out.push_back((char)v);
+}
+
+static unsigned int get_varint(const string& in, size_t& pos)
+{
+  unsigned int v = 0;
+  int shift = 0;
+  while(pos < in.size()){
+      unsigned char byte = in[pos++];
+      v |= (unsigned int)(byte & 0x7f) << shift;
+      if(!(byte & 0x80)) break;
+      shift += 7;
+    }
+  return v;
+}
+
+void LatticeWriter::add(const std::vector<int>& items, int a, int c)
+{
+  std::pair<int,int> key(a, c);
+  std::vector<int> sorted(items);
+  std::sort(sorted.begin(), sorted.end());
+  string& bytes = data[key];
+  put_varint(bytes, sorted.size());
+  int previous = 0;
+  for(int i=0; i<sorted.size(); i++){
+      put_varint(bytes, sorted[i] - previous);
+      previous = sorted[i];
+    }
+  LatticeBucket& bucket = buckets[key];
+  bucket.a = a;
+  bucket.c = c;
+  bucket.nb_patterns++;
+}
+
+int LatticeWriter::write(const string& file, LatticeHeader header)
+{
+  ofstream out(file.c_str(), ofstream::binary);
+  if(!out) return 0;
+  header.nb_patterns = 0;
+  header.nb_buckets = buckets.size();
+  long offset = 0;
+  for(std::map<std::pair<int,int>, LatticeBucket>::iterator it=buckets.begin(); it!=buckets.end(); ++it){
+      it->second.offset = offset;
+      it->second.size = data[it->first].size();
+      offset += it->second.size;
+      header.nb_patterns += it->second.nb_patterns;
+    }
+  out.write(lattice_magic, sizeof(lattice_magic));
+  out.write((const char*)&lattice_version, sizeof(lattice_version));
+  out.write((const char*)&header, sizeof(header));
+  for(std::map<std::pair<int,int>, LatticeBucket>::iterator it=buckets.begin(); it!=buckets.end(); ++it)
+    out.write((const char*)&it->second, sizeof(LatticeBucket));
+  for(std::map<std::pair<int,int>, string>::iterator it=data.begin(); it!=data.end(); ++it)
+    out.write(it->second.data(), it->second.size());
+  return out.good();
+}
+
+int check_lattice_query(const LatticeHeader& header, const MinerConfig& config, string& error)
+{
+  if(config.method != 0) error = "the saved patterns only answer the exhaustive search";
+  else if((config.lamp_alpha != 0) || (config.wy_alpha != 0)) error = "the corrected level of -lamp or -wy depends on all patterns of the search, use -pval";
+  else if(config.max_control != header.max_control) error = "-max changes the items of the patterns, use the -max of the saved run";
+  else if(config.or_threshold < header.or_threshold) error = "-or is lower than the saved run";
+  else if(config.rr_threshold < header.rr_threshold) error = "-gr is lower than the saved run";
+  else if(config.arr_threshold < header.arr_threshold) error = "-ds is lower than the saved run";
+  else if((int)config.min_case_out < header.min_case_out) error = "-min is lower than the saved run";
+  else if((header.p_value != 0) && ((config.p_value == 0) || (config.p_value > header.p_value))) error = "-pval is higher than the saved run";
+  else return 1;
+  return 0;
+}
+
+static int read_header(ifstream& in, const string& file, LatticeHeader& header, string& error)
+{
+  char magic[sizeof(lattice_magic)];
+  int version = 0;
+  in.read(magic, sizeof(magic));
+  in.read((char*)&version, sizeof(version));
+  in.read((char*)&header, sizeof(header));
+  if(!in || !std::equal(magic, magic+sizeof(magic), lattice_magic) || (version != lattice_version)){
+      error = file + " is not a file of closed patterns";
+      return 0;
+    }
+  return 1;
+}
+
+int read_lattice_header(const string& file, LatticeHeader& header, string& error)
+{
+  ifstream in(file.c_str(), ifstream::binary);
+  return read_header(in, file, header, error);
+}
+
+long query_lattice(const string& file, const MinerConfig& config, const PatternSink& sink, LatticeHeader& header, string& error)
+{
+  ifstream in(file.c_str(), ifstream::binary);
+  if(!read_header(in, file, header, error)) return -1;
+  if(!check_lattice_query(header, config, error)) return -1;
+  std::vector<LatticeBucket> index(header.nb_buckets);
+  if(header.nb_buckets > 0) in.read((char*)&index[0], header.nb_buckets*sizeof(LatticeBucket));
+  std::streamoff data_start = in.tellg();
+
+  std::shared_ptr<const FisherTable> fisher = get_fisher_table(header.nb_case, header.nb_control);
+  FisherScope tables(*fisher);
+  long nb_patterns = 0;
+  string bytes;
+  std::vector<int> items;
+  for(int i=0; i<index.size(); i++){
+      LatticeBucket& bucket = index[i];
+      if(!check_pattern_config(bucket.a, bucket.c, header.nb_case, header.nb_control, config)){
+	  //the next buckets of the same a are not admissible either
+	  while((i+1 < index.size()) && (index[i+1].a == bucket.a)) i++;
+	  continue;
+	}
+      bytes.resize(bucket.size);
+      in.seekg(data_start + bucket.offset);
+      if(bucket.size > 0) in.read(&bytes[0], bucket.size);
+      if(!in){
+	  error = file + " is truncated";
+	  return -1;
+	}
+      size_t pos = 0;
+      for(long j=0; j<bucket.nb_patterns; j++){
+	  items.resize(get_varint(bytes, pos));
+	  int item = 0;
+	  for(int k=0; k<items.size(); k++){
+	      item += get_varint(bytes, pos);
+	      items[k] = item;
+	    }
+	  sink(items, bucket.a, bucket.c);
+	  nb_patterns++;
+	}
+    }
+  return nb_patterns;
+}
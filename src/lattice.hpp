@@ -0,0 +1,102 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef LATTICE_HPP_
+#define LATTICE_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "expand_avx.hpp"
+#include "miner.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////CLOSED PATTERN CACHE///////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+The scores of a pattern only depend on its supports (a, c). The patterns of
+an exhaustive run are saved in buckets of equal (a, c), so a query with
+stricter thresholds is answered by checking the scores once per bucket and
+reading only the admissible buckets.
+
+file: header, index of the buckets sorted by (a, c), pattern data
+pattern: number of items then the increasing item ids, delta coded as varints
+For a fixed a, the scores decrease and the p-value increases with c: the
+admissible buckets of each a are a prefix of its buckets.
+ */
+struct LatticeHeader
+{
+  int nb_case;
+  int nb_control;
+  int nb_items;         //number of items of the input file
+  int nb_selected;      //number of items kept by -min and -max
+  float or_threshold;   //thresholds of the saved run
+  float rr_threshold;
+  float arr_threshold;
+  float p_value;
+  int min_case_out;
+  float max_control;
+  long nb_patterns;
+  int nb_buckets;
+};
+
+struct LatticeBucket
+{
+  int a;
+  int c;
+  long offset;        //position of the patterns in the data section
+  long size;          //number of bytes
+  long nb_patterns;
+};
+
+class LatticeWriter
+{
+ public:
+  void add(const std::vector<int>& items, int a, int c);
+  int write(const string& file, LatticeHeader header);  //0 if the file cannot be written
+
+ private:
+  std::map<std::pair<int,int>, LatticeBucket> buckets;
+  std::map<std::pair<int,int>, string> data;
+};
+
+//read the header of a file of patterns, 0 and error on failure
+int read_lattice_header(const string& file, LatticeHeader& header, string& error);
+
+//check that a query is answered exactly by the saved patterns, 0 and error otherwise
+int check_lattice_query(const LatticeHeader& header, const MinerConfig& config, string& error);
+
+//send the saved patterns satisfying the thresholds of config to sink, -1 and error on failure
+long query_lattice(const string& file, const MinerConfig& config, const PatternSink& sink, LatticeHeader& header, string& error);
+
+#endif /* LATTICE_HPP_ */
@@ -0,0 +1,329 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <immintrin.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "loader.hpp"
+#include "stats.hpp"
+#include "perf.hpp"
+
+using namespace std;
+
+//read the number of cases and controls in the first line of a matrix file ("# nb_case nb_control")
+//return false if the file cannot be read
+int read_header(const string& file, int& nb_case, int& nb_control)
+{
+  ifstream para (file.c_str() , ifstream::in);
+  string first_line;
+  getline(para,first_line);
+  stringstream ss(first_line);
+  string sharp;
+  if(!(ss>>sharp>>nb_case>>nb_control) || sharp!="#") return false;
+  return true;
+}
+
+//check the format of a matrix file: "# nb_case nb_control sparse" in the first line
+int is_sparse_file(const string& file)
+{
+  ifstream para (file.c_str() , ifstream::in);
+  string first_line;
+  getline(para,first_line);
+  stringstream ss(first_line);
+  string sharp, format;
+  int nb_case, nb_control;
+  return (ss>>sharp>>nb_case>>nb_control>>format) && (format=="sparse");
+}
+
+//pack a line of '0'/'1' characters into a tidset
+//case tids fill the first case_registers registers, control tids start at a fresh register
+Tidset_vector pack_line(const string& line, int nb_case, int nb_control, int case_registers, int control_registers)
+{
+  Tidset_vector tmp(case_registers+control_registers, _mm256_setzero_si256());
+  unsigned long long* f = (unsigned long long*)&tmp[0];
+  int nb_sample = std::min((int)line.size(), nb_case+nb_control);
+  for(int i=0; i<nb_sample; i++)
+    if(line[i]=='1'){
+      int pos = (i<nb_case) ? i : case_registers*nb_bits + (i-nb_case);
+      f[pos >> 6] |= (1ULL << (pos & 63));
+    }
+  return tmp;
+}
+
+//check the supports of an item in both classes
+int select_row(const string& line, int nb_case, int nb_control, float min_case, float max_control)
+{
+  int bb_case = 0;
+  int bb_control = 0;
+  int nb_sample = std::min((int)line.size(), nb_case+nb_control);
+  for(int i=0; i<nb_sample; i++)
+    if(line[i]=='1'){
+      if (i<nb_case) bb_case++;
+      else bb_control++;}
+  //the p-value threshold is checked on patterns during the search, not on single items
+  return ( (max_control < 0) || (bb_control <= max_control) ) && (bb_case >= min_case);
+}
+
+//order of the case samples by support (1: ascending, -1: descending), perm[i] is the sample at position i
+std::vector<int> case_permutation(const std::vector<int>& support, int case_order)
+{
+  vector<int> perm(support.size());
+  for(int i=0; i<perm.size(); i++) perm[i] = i;
+  std::stable_sort(perm.begin(), perm.end(), [&](int x, int y){
+      return (case_order>0) ? (support[x] < support[y]) : (support[x] > support[y]); });
+  return perm;
+}
+
+//reorder and pack the selected rows
+static Transaction pack_rows(vector<string>& rows, vector<int>& labels, int nb_case, int nb_control, int case_order, int item_order)
+{
+  PhaseTimer filter_timer(PHASE_FILTER);
+  PerfScope filter_perf(PERF_FILTER);
+  int nb_sample = nb_case + nb_control;
+
+  //reorder case samples by their support (number of selected items containing them)
+  if(case_order!=0){
+      vector<int> support(nb_case, 0);
+      for(int r=0; r<rows.size(); r++)
+	for(int i=0; i<nb_case; i++)
+	  if(rows[r][i]=='1') support[i]++;
+      vector<int> perm = case_permutation(support, case_order);
+      for(int r=0; r<rows.size(); r++){
+	  string tmp = rows[r];
+	  for(int i=0; i<nb_case; i++) tmp[i] = rows[r][perm[i]];
+	  rows[r] = tmp;
+	}
+    }
+
+  //reorder items by their support, the original ids are kept in labels
+  vector<int> order(rows.size());
+  for(int r=0; r<rows.size(); r++) order[r] = r;
+  if(item_order!=0){
+      vector<int> support(rows.size(), 0);
+      for(int r=0; r<rows.size(); r++)
+	for(int i=0; i<nb_sample; i++)
+	  if(rows[r][i]=='1') support[r]++;
+      std::stable_sort(order.begin(), order.end(), [&](int x, int y){
+	  return (item_order>0) ? (support[x] < support[y]) : (support[x] > support[y]); });
+    }
+
+  //cases and controls are stored in separate registers
+  int case_registers = (nb_case + nb_bits - 1) / nb_bits; //nb of registers of cases
+  int control_registers = (nb_control + nb_bits - 1) / nb_bits; //nb of registers of controls
+
+  //add selected items to transaction
+  Transaction transaction;
+  for(int r=0; r<order.size(); r++){
+      ITEM tid;
+      tid.id = r;
+      tid.label = labels[order[r]];
+      transaction.push_back(pack_line(rows[order[r]], nb_case, nb_control, case_registers, control_registers));
+      tid.support = get_size(transaction.back());
+      tid.signature = tidset_signature(transaction.back());
+      transaction.tidset.push_back(tid);
+    }
+
+  transaction.nb_case = nb_case;//number of case samples
+  transaction.nb_control = nb_control; //number of control samples
+  transaction.nb_sample = nb_sample; //total number of samples
+  transaction.case_registers = case_registers;
+  transaction.control_registers = control_registers;
+
+  //init itemset of case group and of control group
+  transaction.case_itemset = pack_line(string(nb_case,'1') + string(nb_control,'0'), nb_case, nb_control, case_registers, control_registers);
+  transaction.control_itemset = pack_line(string(nb_case,'0') + string(nb_control,'1'), nb_case, nb_control, case_registers, control_registers);
+  return transaction;
+}
+
+//reorder the packed rows of the selected items (labels: their original ids) and build a dataset
+Transaction pack_bitrows(std::vector<Tidset_vector>& rows, const std::vector<int>& labels, int nb_case, int nb_control, int case_order, int item_order)
+{
+  PhaseTimer filter_timer(PHASE_FILTER);
+  PerfScope filter_perf(PERF_FILTER);
+  int case_registers = (nb_case + nb_bits - 1) / nb_bits;
+  int control_registers = (nb_control + nb_bits - 1) / nb_bits;
+  //reorder case samples by their support (number of selected items containing them)
+  if(case_order!=0){
+      std::vector<int> support(nb_case, 0);
+      for(int r=0; r<rows.size(); r++){
+	  const unsigned long long* f = (const unsigned long long*)&rows[r][0];
+	  for(int i=0; i<nb_case; i++)
+	    if((f[i >> 6] >> (i & 63)) & 1ULL) support[i]++;
+	}
+      std::vector<int> perm = case_permutation(support, case_order);
+      for(int r=0; r<rows.size(); r++){
+	  Tidset_vector tmp = rows[r];
+	  const unsigned long long* f = (const unsigned long long*)&rows[r][0];
+	  unsigned long long* g = (unsigned long long*)&tmp[0];
+	  for(int w=0; w<case_registers*(nb_bits/64); w++) g[w] = 0;
+	  for(int i=0; i<nb_case; i++)
+	    if((f[perm[i] >> 6] >> (perm[i] & 63)) & 1ULL) g[i >> 6] |= (1ULL << (i & 63));
+	  rows[r].swap(tmp);
+	}
+    }
+
+  //reorder items by their support, the original ids are kept in labels
+  std::vector<int> order(rows.size());
+  std::vector<int> support(rows.size());
+  for(int r=0; r<rows.size(); r++){
+      order[r] = r;
+      support[r] = get_size(rows[r]);
+    }
+  if(item_order!=0)
+    std::stable_sort(order.begin(), order.end(), [&](int x, int y){
+	return (item_order>0) ? (support[x] < support[y]) : (support[x] > support[y]); });
+
+  Transaction transaction;
+  transaction.reserve(rows.size());
+  transaction.tidset.reserve(rows.size());
+  for(int r=0; r<order.size(); r++){
+      ITEM tid;
+      tid.id = r;
+      tid.label = labels[order[r]];
+      tid.support = support[order[r]];
+      tid.signature = tidset_signature(rows[order[r]]);
+      transaction.push_back(std::move(rows[order[r]]));
+      transaction.tidset.push_back(tid);
+    }
+  transaction.nb_case = nb_case;
+  transaction.nb_control = nb_control;
+  transaction.nb_sample = nb_case + nb_control;
+  transaction.case_registers = case_registers;
+  transaction.control_registers = control_registers;
+  transaction.case_itemset = pack_line(string(nb_case,'1') + string(nb_control,'0'), nb_case, nb_control, case_registers, control_registers);
+  transaction.control_itemset = pack_line(string(nb_case,'0') + string(nb_control,'1'), nb_case, nb_control, case_registers, control_registers);
+  return transaction;
+}
+
+//read the lines of a sparse matrix file (sample ids of each item) into packed rows
+static Transaction load_sparse(const string& file, float min_case, float max_control, int case_order, int item_order, int& nb_items)
+{
+  PhaseTimer load_timer(PHASE_LOAD);
+  PerfScope load_perf(PERF_LOAD);
+  int nb_case = 0;
+  int nb_control = 0;
+  read_header(file, nb_case, nb_control);
+  int nb_sample = nb_case + nb_control;
+  int case_registers = (nb_case + nb_bits - 1) / nb_bits;
+  int control_registers = (nb_control + nb_bits - 1) / nb_bits;
+
+  vector<Tidset_vector> rows;  //rows of the selected items
+  vector<int> labels;          //original ids of the selected items
+  nb_items = 0;
+  ifstream database (file.c_str() , ifstream::in);
+  string line;
+  getline(database,line);
+  while(getline(database,line)){
+      if(!line.empty() && (line[0]=='#')) continue;
+      //scatter the sample ids into the row, ids out of the samples are ignored
+      Tidset_vector row(case_registers + control_registers, _mm256_setzero_si256());
+      unsigned long long* f = (unsigned long long*)&row[0];
+      int bb_case = 0;
+      int bb_control = 0;
+      const char* str = line.c_str();
+      char* end;
+      for(long i=strtol(str, &end, 10); end!=str; i=strtol(str, &end, 10)){
+	  str = end;
+	  if((i<0) || (i>=nb_sample)) continue;
+	  int pos = (i<nb_case) ? i : case_registers*nb_bits + (i-nb_case);
+	  if((f[pos >> 6] >> (pos & 63)) & 1ULL) continue;
+	  f[pos >> 6] |= (1ULL << (pos & 63));
+	  if(i<nb_case) bb_case++;
+	  else bb_control++;
+	}
+      if( ((max_control < 0) || (bb_control <= max_control)) && (bb_case >= min_case) ){
+	  rows.push_back(std::move(row));
+	  labels.push_back(nb_items);
+	}
+      nb_items++;
+    }
+  load_timer.stop();
+  load_perf.stop();
+  return pack_bitrows(rows, labels, nb_case, nb_control, case_order, item_order);
+}
+
+//load a matrix file, nb_items is the number of items in the file (before the selection)
+Transaction load_transaction(const string& file, float min_case, float max_control, int case_order, int item_order, int& nb_items)
+{
+  if(is_sparse_file(file)) return load_sparse(file, min_case, max_control, case_order, item_order, nb_items);
+  PhaseTimer load_timer(PHASE_LOAD);
+  PerfScope load_perf(PERF_LOAD);
+  int nb_case = 0;
+  int nb_control = 0;
+  read_header(file, nb_case, nb_control);
+
+  //select items based on case and control supports
+  vector<string> rows;  //rows of the selected items
+  vector<int> labels;   //original ids of the selected items
+  nb_items = 0;
+  ifstream database (file.c_str() , ifstream::in);
+  while(database.good())    {
+      //read line
+      string line;
+      getline(database,line);
+      if(!line.empty() && (line[0]!='#'))	{
+	  if(select_row(line, nb_case, nb_control, min_case, max_control)){
+	      rows.push_back(line);
+	      labels.push_back(nb_items);
+	    }
+	  nb_items++;
+	}
+    }
+  load_timer.stop();
+  load_perf.stop();
+  return pack_rows(rows, labels, nb_case, nb_control, case_order, item_order);
+}
+
+//read the lines of the items of a matrix file, return 0 if the file cannot be read
+int read_matrix(const string& file, std::vector<string>& matrix)
+{
+  ifstream database (file.c_str() , ifstream::in);
+  if(!database) return false;
+  string line;
+  while(getline(database,line))
+    if(!line.empty() && (line[0]!='#'))
+      matrix.push_back(line);
+  return true;
+}
+
+//build a dataset from a matrix in memory (one string per item)
+Transaction build_transaction(const std::vector<string>& matrix, int nb_case, int nb_control, float min_case, float max_control, int case_order, int item_order)
+{
+  vector<string> rows;
+  vector<int> labels;
+  for(int r=0; r<matrix.size(); r++)
+    if(select_row(matrix[r], nb_case, nb_control, min_case, max_control)){
+      rows.push_back(matrix[r]);
+      labels.push_back(r);
+    }
+  return pack_rows(rows, labels, nb_case, nb_control, case_order, item_order);
+}
@@ -0,0 +1,65 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#ifndef LOADER_HPP_
+#define LOADER_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "expand_avx.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////LOADING OF THE BINARY MATRIX///////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+A matrix is a set of lines of '0'/'1' characters (one line per item, one
+column per sample, the cases first). Items are selected by their supports
+(at least min_case cases, at most max_control controls, max_control < 0: no
+limit), the case samples and the items can be reordered by support, then
+the lines are packed into a Transaction. Items keep their line number in
+the file as label.
+A sparse matrix ("# nb_case nb_control sparse" in the first line) has one
+line of sample ids per item instead (0 to nb_case-1: cases, then controls),
+scattered straight into the rows, so its size and loading time follow the
+number of ones.
+ */
+int read_header(const string& file, int& nb_case, int& nb_control);
+int is_sparse_file(const string& file);
+Tidset_vector pack_line(const string& line, int nb_case, int nb_control, int case_registers, int control_registers);
+int select_row(const string& line, int nb_case, int nb_control, float min_case, float max_control);
+std::vector<int> case_permutation(const std::vector<int>& support, int case_order);
+int read_matrix(const string& file, std::vector<string>& matrix);
+Transaction pack_bitrows(std::vector<Tidset_vector>& rows, const std::vector<int>& labels, int nb_case, int nb_control, int case_order, int item_order);
+Transaction load_transaction(const string& file, float min_case, float max_control, int case_order, int item_order, int& nb_items);
+Transaction build_transaction(const std::vector<string>& matrix, int nb_case, int nb_control, float min_case, float max_control, int case_order, int item_order);
+
+#endif /* LOADER_HPP_ */
@@ -0,0 +1,79 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#include <immintrin.h>
+#include <new>
+
+#include "memory.hpp"
+
+using namespace std;
+
+thread_local MemoryUsage thread_memory = {0, 0};
+long memory_limit = 0;
+std::atomic<long> memory_used(0);
+std::atomic<bool> memory_exhausted(false);
+
+//the bytes allocated before are counted from the bytes of the calling thread
+void set_memory_limit(long bytes)
+{
+  memory_used.store(bytes ? thread_memory.bytes : 0);
+  memory_limit = bytes;
+}
+
+thread_local Arena thread_arena;
+
+Arena::~Arena()
+{
+  for(std::size_t i=0; i<chunks.size(); i++)
+    _mm_free(chunks[i].base);
+}
+
+//the chunk in use is full: the block of n bytes starts the next chunk
+//(the chunks after the one in use are free, a chunk too small is replaced)
+void* arena_grow(std::size_t n)
+{
+  Arena& arena = thread_arena;
+  std::size_t next = (arena.chunk < arena.chunks.size()) ? arena.chunk + 1 : arena.chunk;
+  if( (next < arena.chunks.size()) && (arena.chunks[next].size < n) ){
+      for(std::size_t i=next; i<arena.chunks.size(); i++)
+	_mm_free(arena.chunks[i].base);
+      arena.chunks.resize(next);
+    }
+  if(next == arena.chunks.size()){
+      std::size_t size = arena.chunks.empty() ? arena_chunk_size : 2*arena.chunks.back().size;
+      while(size < n) size *= 2;
+      ArenaChunk chunk;
+      chunk.base = (char*)_mm_malloc(size, arena_alignment);
+      if(chunk.base == NULL) throw std::bad_alloc();
+      chunk.size = size;
+      arena.chunks.push_back(chunk);
+    }
+  arena.chunk = next;
+  arena.offset = n;
+  return arena.chunks[next].base;
+}
@@ -0,0 +1,194 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef MEMORY_HPP_
+#define MEMORY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////MEMORY ACCOUNTING//////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+The aligned allocator of the tidsets (datasets, reduced datasets and
+temporaries of the search) counts the bytes of each thread. With a memory
+limit, the bytes of all threads are also summed: above 3/4 of the limit the
+search stops copying reduced datasets, above the limit it stops and the
+output is partial.
+ */
+struct MemoryUsage
+{
+  long bytes;  //bytes allocated by the thread
+  long peak;   //largest value of bytes
+};
+
+extern thread_local MemoryUsage thread_memory;
+extern long memory_limit;                  //bytes (0: no limit)
+extern std::atomic<long> memory_used;      //bytes of all threads, counted with a limit only
+extern std::atomic<bool> memory_exhausted; //the limit has been reached
+
+inline void memory_allocated(std::size_t n)
+{
+  thread_memory.bytes += n;
+  if(thread_memory.bytes > thread_memory.peak) thread_memory.peak = thread_memory.bytes;
+  if(memory_limit && (memory_used.fetch_add(n, std::memory_order_relaxed) + (long)n > memory_limit))
+    memory_exhausted.store(true, std::memory_order_relaxed);
+}
+
+inline void memory_freed(std::size_t n)
+{
+  thread_memory.bytes -= n;
+  if(memory_limit) memory_used.fetch_sub(n, std::memory_order_relaxed);
+}
+
+//true when the search should use less memory
+inline bool memory_tight()
+{
+  return memory_limit && (memory_used.load(std::memory_order_relaxed) > memory_limit/4*3);
+}
+
+void set_memory_limit(long bytes);
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////ARENA OF THE SEARCH////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+The temporaries of a node of the search (tidsets, tidlists, reduced datasets)
+are freed when the node returns, in the reverse order of their allocation.
+Each node opens an ArenaFrame: while a frame is open, the aligned allocator
+takes its blocks from a stack of chunks of the thread instead of the heap, a
+free only gives back the block on top of the stack (e.g. the tidset copied for
+a child once the child returns) and the frame gives back all its blocks at once
+when it is closed. The chunks are kept by the thread for the next nodes and searches.
+The bytes in use of the arena are counted as the other allocations.
+ */
+const std::size_t arena_alignment = 32;          //alignment of the blocks (one AVX2 register)
+const std::size_t arena_chunk_size = 1 << 20;    //bytes of the 1st chunk, the next ones double
+
+struct ArenaChunk
+{
+  char* base;
+  std::size_t size;
+};
+
+struct Arena
+{
+  std::vector<ArenaChunk> chunks;
+  std::size_t chunk;   //chunk in use
+  std::size_t offset;  //first free byte of the chunk in use
+  long used;           //bytes given by the arena and not released
+  int frames;          //open frames (0: the blocks come from the heap)
+  std::size_t frame_chunk;  //top of the stack when the innermost frame was opened
+  std::size_t frame_offset;
+  Arena() : chunk(0), offset(0), used(0), frames(0), frame_chunk(0), frame_offset(0) {}
+  ~Arena();
+};
+
+extern thread_local Arena thread_arena;
+
+void* arena_grow(std::size_t n);
+
+//block of n bytes on top of the stack of the thread
+inline void* arena_allocate(std::size_t n)
+{
+  Arena& arena = thread_arena;
+  n = (n + arena_alignment - 1) & ~(arena_alignment - 1);
+  memory_allocated(n);
+  arena.used += n;
+  if( (arena.chunk < arena.chunks.size()) && (arena.offset + n <= arena.chunks[arena.chunk].size) ){
+      void* p = arena.chunks[arena.chunk].base + arena.offset;
+      arena.offset += n;
+      return p;
+    }
+  return arena_grow(n);
+}
+
+//true if p is a block of the arena of the thread (it is freed by its frame)
+inline bool arena_owns(const void* p)
+{
+  const std::vector<ArenaChunk>& chunks = thread_arena.chunks;
+  for(std::size_t i=0; i<chunks.size(); i++)
+    if( ((const char*)p >= chunks[i].base) && ((const char*)p < chunks[i].base + chunks[i].size) ) return true;
+  return false;
+}
+
+//a block of n bytes that is on top of the stack and above the innermost frame is given back
+inline void arena_free(void* p, std::size_t n)
+{
+  Arena& arena = thread_arena;
+  n = (n + arena_alignment - 1) & ~(arena_alignment - 1);
+  if( (arena.chunk >= arena.chunks.size()) || ((char*)p + n != arena.chunks[arena.chunk].base + arena.offset) ) return;
+  if( (arena.chunk == arena.frame_chunk) && (arena.offset - n < arena.frame_offset) ) return;
+  arena.offset -= n;
+  arena.used -= n;
+  memory_freed(n);
+}
+
+//frame of a node of the search: the blocks allocated while it is the innermost
+//frame are released when it is closed (no block may outlive it)
+struct ArenaFrame
+{
+  std::size_t chunk;
+  std::size_t offset;
+  long used;
+  std::size_t frame_chunk;  //innermost frame before this one
+  std::size_t frame_offset;
+  ArenaFrame() : chunk(thread_arena.chunk), offset(thread_arena.offset), used(thread_arena.used),
+		 frame_chunk(thread_arena.frame_chunk), frame_offset(thread_arena.frame_offset) {
+    thread_arena.frames++;
+    thread_arena.frame_chunk = chunk;
+    thread_arena.frame_offset = offset;
+  }
+  ~ArenaFrame() {
+    Arena& arena = thread_arena;
+    memory_freed(arena.used - used);
+    arena.used = used;
+    arena.chunk = chunk;
+    arena.offset = offset;
+    arena.frame_chunk = frame_chunk;
+    arena.frame_offset = frame_offset;
+    arena.frames--;
+  }
+};
+
+//the allocations of a scope come from the heap although a frame is open
+//(the patterns given to a sink may be kept after the node returns)
+struct ArenaPause
+{
+  int frames;
+  ArenaPause() : frames(thread_arena.frames) { thread_arena.frames = 0; }
+  ~ArenaPause() { thread_arena.frames = frames; }
+};
+
+#endif /* MEMORY_HPP_ */
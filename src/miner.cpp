@@ -0,0 +1,186 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <immintrin.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "miner.hpp"
+#include "loader.hpp"
+#include "exhaustiveSearch.hpp"
+#include "heuristicSearch.hpp"
+#include "progress.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+int check_pattern_config(int a, int c, int nb_case, int nb_control, const MinerConfig& config)
+{
+  if(a < (int)config.min_case_out) return false;
+  if(c == 0) return (config.p_value == 0) || (fisher_pvalue(a, 0) <= config.p_value);
+  return check_support_score(a, c, nb_case, nb_control, config.or_threshold, config.rr_threshold, config.arr_threshold, config.p_value, config.min_case_out);
+}
+
+//dataset already packed: only the items selected by the configuration are kept
+Miner::Miner(Transaction&& data, const MinerConfig& cfg) : config(cfg), corrected(0), nb_closed(0), stopped(0), nb_pruning_case(0), nb_pruning_control(0)
+{
+  Tidlist tid = select_items(data);
+  if(tid.size() == data.size()) transaction = std::move(data);
+  else transaction = reduced_dataset_avx(tid, data);
+  fisher = get_fisher_table(transaction.nb_case, transaction.nb_control);
+}
+
+//dataset shared with other miners: the selected items are copied, data is only read
+Miner::Miner(Transaction& data, const MinerConfig& cfg) : config(cfg), corrected(0), nb_closed(0), stopped(0), nb_pruning_case(0), nb_pruning_control(0)
+{
+  Tidlist tid = select_items(data);
+  transaction = reduced_dataset_avx(tid, data);
+  fisher = get_fisher_table(transaction.nb_case, transaction.nb_control);
+}
+
+//matrix in memory: one string of '0'/'1' per item, the cases first
+Miner::Miner(const std::vector<string>& matrix, int nb_case, int nb_control, const MinerConfig& cfg)
+  : config(cfg), corrected(0), nb_closed(0), stopped(0), nb_pruning_case(0), nb_pruning_control(0)
+{
+  transaction = build_transaction(matrix, nb_case, nb_control, config.min_case, config.max_control, config.case_order, config.item_order);
+  fisher = get_fisher_table(nb_case, nb_control);
+}
+
+//items whose supports satisfy min_case and max_control
+Tidlist Miner::select_items(Transaction& data)
+{
+  Tidlist tid;
+  for(int i=0; i<data.size(); i++){
+      int a = 0;
+      int c = 0;
+      get_support(data[i], data, a, c);
+      if( ((config.max_control < 0) || (c <= config.max_control)) && (a >= config.min_case) )
+	tid.push_back(i);
+    }
+  return tid;
+}
+
+//1st pass of the multiple testing correction (exhaustive search only), nothing is sent to a sink:
+//the p-value threshold of the configuration becomes the corrected level (or stays if it is smaller)
+void Miner::correct()
+{
+  if(corrected) return;
+  FisherScope tables(*fisher);
+  if(config.method != 0){
+      corrected = 1;
+      return;
+    }
+  PatternSink no_sink = [](const std::vector<int>&, int, int){};
+  int nb_registers = transaction.case_registers + transaction.control_registers;
+  float no_p_val = 0;
+  int nb_patterns = 0;
+  if(config.wy_alpha != 0){
+      //smallest p-value of each permutation over the closed patterns of all tids
+      //(the classes are ignored, all tids are put in the 1st class)
+      Transaction merged = merge_classes_avx(transaction);
+      init_westfall_young(sig, config.wy_alpha, config.nb_permutations, config.seed, transaction.nb_case, transaction.nb_control);
+      progress_pass(merged.nb_case);
+      for(int e=0; (e<merged.nb_case) && !search_cancelled(); e++){
+	  Tidset_vector p(merged.case_registers, _mm256_setzero_si256());
+	  expand_case_exh(p, e, config.or_threshold, config.rr_threshold, config.arr_threshold, no_p_val, sig, no_sink, 0, nb_patterns, nb_pruning_case, merged, merged.case_registers, nb_pruning_control);
+	  progress_seed(e + 1);
+	}
+      if(search_cancelled()) return;
+      sig.mode = 2;
+      float wy_p_val = float_threshold(sig.delta, true);
+      if((config.p_value == 0) || (wy_p_val < config.p_value)) config.p_value = wy_p_val;
+    } else if(config.lamp_alpha != 0){
+      //count the testable patterns and find the corrected level
+      int first_case = std::max(0, (int)config.min_case_out-1);
+      init_lamp(sig, config.lamp_alpha, transaction.nb_case, transaction.nb_control);
+      progress_pass(transaction.nb_case - first_case);
+      for(int e=first_case; (e<transaction.nb_case) && !search_cancelled(); e++){
+	  Tidset_vector p(nb_registers, _mm256_setzero_si256());
+	  expand_case_exh(p, e, config.or_threshold, config.rr_threshold, config.arr_threshold, no_p_val, sig, no_sink, config.min_case_out, nb_patterns, nb_pruning_case, transaction, nb_registers, nb_pruning_control);
+	  progress_seed(e - first_case + 1);
+	}
+      if(search_cancelled()) return;
+      sig.mode = 2;
+      float lamp_p_val = float_threshold(sig.delta, false);
+      if((config.p_value == 0) || (lamp_p_val < config.p_value)) config.p_value = lamp_p_val;
+    }
+  corrected = 1;
+  nb_closed = nb_patterns;
+  nb_pruning_case = 0;
+  nb_pruning_control = 0;
+}
+
+//mine the dataset and send each pattern to sink, return the number of patterns
+//the search stops at the next node once token is cancelled (a cancelled 1st pass is done again by the next call)
+long Miner::mine(const PatternSink& sink, const CancelToken* token)
+{
+  CancelScope scope(token);
+  FisherScope tables(*fisher);
+  correct();
+  if(!corrected) return 0;
+  int nb_patterns = 0;
+  int nb_registers = transaction.case_registers + transaction.control_registers;
+  int nb_case = transaction.nb_case;
+  if(config.method == 1){
+      int nb_it = 0; //number of iterations (running steps)
+      //start from largest tid
+      progress_pass(nb_case - std::max(0, (int)config.min_case));
+      for(int e=nb_case-1; (e>=config.min_case) && (nb_it<config.it_threshold) && !search_cancelled(); e--){
+	  Tidset_vector p(nb_registers, _mm256_setzero_si256());
+	  //expand p wich each of tid in case (e)
+	  expand_case_heu(p, e, config.or_threshold, config.rr_threshold, config.arr_threshold, config.p_value, sink, config.min_case_out, config.it_threshold, nb_patterns, nb_pruning_case, transaction, nb_registers, nb_it);
+	  progress_seed(nb_case - e);
+	}
+      stopped = (nb_it >= config.it_threshold);
+    } else {
+      //start from the smallest tid
+      //a pattern found from seed e holds at most e+1 cases, smaller seeds cannot reach min_case_out
+      int first_case = std::max(0, (int)config.min_case_out-1);
+      //no pattern is significant if the corrected level is 0
+      if((sig.mode==2) && (config.p_value==0)) first_case = nb_case;
+      progress_pass(nb_case - first_case);
+      for(int e=first_case; (e<nb_case) && !search_cancelled(); e++){
+	  Tidset_vector p(nb_registers, _mm256_setzero_si256());
+	  //expand p with each tid in case group
+	  expand_case_exh(p, e, config.or_threshold, config.rr_threshold, config.arr_threshold, config.p_value, sig, sink, config.min_case_out, nb_patterns, nb_pruning_case, transaction, nb_registers, nb_pruning_control);
+	  progress_seed(e - first_case + 1);
+	}
+    }
+  return nb_patterns;
+}
+
+//exhaustive search of the patterns whose largest case is e, in data: a dataset with the samples of
+//the miner holding (at least) the selected items containing e, the 1st pass of the correction is not run
+long Miner::mine_seed(int e, Transaction& data, const PatternSink& sink)
+{
+  FisherScope tables(*fisher);
+  int nb_patterns = 0;
+  int nb_registers = data.case_registers + data.control_registers;
+  Tidset_vector p(nb_registers, _mm256_setzero_si256());
+  expand_case_exh(p, e, config.or_threshold, config.rr_threshold, config.arr_threshold, config.p_value, sig, sink, config.min_case_out, nb_patterns, nb_pruning_case, data, nb_registers, nb_pruning_control);
+  return nb_patterns;
+}
@@ -0,0 +1,107 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#ifndef MINER_HPP_
+#define MINER_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "expand_avx.hpp"
+#include "significance.hpp"
+#include "cancel.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////LIBRARY INTERFACE//////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+A Miner holds a dataset in memory and mines it with a configuration; each
+pattern is sent to a PatternSink as (original ids of its items, a, c).
+The supports of the configuration are numbers of samples (not percents).
+
+  MinerConfig config;
+  config.or_threshold = 2;
+  Miner miner(load_transaction("input.txt", 0, -1, 0, 0, nb_items), config);
+  miner.mine([](const std::vector<int>& items, int a, int c){ ... });
+ */
+struct MinerConfig
+{
+  float or_threshold;    //odds ratio threshold
+  float rr_threshold;    //risk ratio threshold
+  float arr_threshold;   //absolute risk reduction threshold
+  float p_value;         //p-value threshold (0: not used)
+  float min_case;        //minimal number of cases containing an item
+  float max_control;     //maximal number of controls containing an item (<0: no limit)
+  float min_case_out;    //minimal number of cases of an output pattern
+  int method;            //0: exhaustive search, 1: heuristic search
+  int it_threshold;      //number of searching steps of the heuristic search
+  int case_order;        //order of case samples of a matrix in memory (0: none, 1: asc, -1: desc)
+  int item_order;        //order of items of a matrix in memory
+  float lamp_alpha;      //family-wise error rate of LAMP (0: not used)
+  float wy_alpha;        //family-wise error rate of Westfall-Young (0: not used)
+  int nb_permutations;   //number of permutations of Westfall-Young
+  unsigned int seed;     //seed of the permutations
+
+  MinerConfig() : or_threshold(1), rr_threshold(1), arr_threshold(0), p_value(0), min_case(0), max_control(-1), min_case_out(0),
+		  method(0), it_threshold(1000000), case_order(0), item_order(0), lamp_alpha(0), wy_alpha(0), nb_permutations(1000), seed(0) {}
+};
+
+//check if a pattern covering a cases and c controls is output by the exhaustive search with config
+//(the same checks as the search: p-value only without control, then all scores)
+int check_pattern_config(int a, int c, int nb_case, int nb_control, const MinerConfig& config);
+
+class Miner
+{
+ public:
+  Miner(Transaction&& data, const MinerConfig& config);
+  Miner(Transaction& data, const MinerConfig& config);
+  Miner(const std::vector<string>& matrix, int nb_case, int nb_control, const MinerConfig& config);
+
+  void correct();
+  long mine(const PatternSink& sink, const CancelToken* token = nullptr);
+  long mine_seed(int e, Transaction& data, const PatternSink& sink);
+
+  MinerConfig config;
+  Transaction transaction;   //dataset restricted to the selected items
+  Significance sig;          //state of the multiple testing correction
+  std::shared_ptr<const FisherTable> fisher; //tables of Fisher's exact test of the dataset size
+  int corrected;             //1 if the 1st pass of the correction is done
+  long nb_closed;            //number of closed patterns of the 1st pass
+  int stopped;               //1 if the heuristic search stopped after it_threshold steps
+  int nb_pruning_case;
+  int nb_pruning_control;
+
+ private:
+  Tidlist select_items(Transaction& data);
+};
+
+#endif /* MINER_HPP_ */
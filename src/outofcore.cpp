@@ -0,0 +1,201 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "outofcore.hpp"
+#include "loader.hpp"
+#include "stats.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+int scan_matrix(const string& file, float min_case, float max_control, int case_order, OutOfCoreScan& scan)
+{
+  PhaseTimer load_timer(PHASE_LOAD);
+  if(!read_header(file, scan.nb_case, scan.nb_control)) return false;
+  ifstream database (file.c_str() , ifstream::in);
+  if(!database) return false;
+  std::vector<int> support(scan.nb_case, 0);
+  scan.nb_items = 0;
+  scan.nb_selected = 0;
+  string line;
+  while(getline(database,line))
+    if(!line.empty() && (line[0]!='#')){
+	if(select_row(line, scan.nb_case, scan.nb_control, min_case, max_control)){
+	    int nb = std::min((int)line.size(), scan.nb_case);
+	    for(int i=0; i<nb; i++)
+	      if(line[i]=='1') support[i]++;
+	    scan.nb_selected++;
+	  }
+	scan.nb_items++;
+      }
+  if(case_order!=0) scan.perm = case_permutation(support, case_order);
+  else {
+      scan.perm.resize(scan.nb_case);
+      for(int i=0; i<scan.nb_case; i++) scan.perm[i] = i;
+    }
+  scan.support.resize(scan.nb_case);
+  for(int i=0; i<scan.nb_case; i++) scan.support[i] = support[scan.perm[i]];
+  return true;
+}
+
+void project_seeds(const string& file, const OutOfCoreScan& scan, float min_case, float max_control, int first, int last, std::vector<Transaction>& projected)
+{
+  PhaseTimer load_timer(PHASE_LOAD);
+  int nb_case = scan.nb_case;
+  int nb_control = scan.nb_control;
+  int case_registers = (nb_case + nb_bits - 1) / nb_bits;
+  int control_registers = (nb_control + nb_bits - 1) / nb_bits;
+  Tidset_vector case_itemset = pack_line(string(nb_case,'1') + string(nb_control,'0'), nb_case, nb_control, case_registers, control_registers);
+  Tidset_vector control_itemset = pack_line(string(nb_case,'0') + string(nb_control,'1'), nb_case, nb_control, case_registers, control_registers);
+  projected.assign(last - first, Transaction());
+  for(int s=0; s<projected.size(); s++){
+      Transaction& data = projected[s];
+      data.reserve(scan.support[first + s]);
+      data.tidset.reserve(scan.support[first + s]);
+      data.nb_case = nb_case;
+      data.nb_control = nb_control;
+      data.nb_sample = nb_case + nb_control;
+      data.case_registers = case_registers;
+      data.control_registers = control_registers;
+      data.case_itemset = case_itemset;
+      data.control_itemset = control_itemset;
+    }
+
+  ifstream database (file.c_str() , ifstream::in);
+  int label = 0;
+  string line;
+  string ordered;
+  while(getline(database,line))
+    if(!line.empty() && (line[0]!='#')){
+	if(select_row(line, nb_case, nb_control, min_case, max_control)){
+	    //cases in the order of the 1st scan
+	    ordered = line;
+	    for(int i=0; (i<nb_case) && (scan.perm[i]<line.size()); i++) ordered[i] = line[scan.perm[i]];
+	    Tidset_vector row = pack_line(ordered, nb_case, nb_control, case_registers, control_registers);
+	    const unsigned long long* f = (const unsigned long long*)&row[0];
+	    ITEM item;
+	    item.label = label;
+	    item.support = get_size(row);
+	    item.signature = tidset_signature(row);
+	    //the row goes to the dataset of each seed of the batch it contains
+	    for(int e=first; e<last; e++)
+	      if((f[e >> 6] >> (e & 63)) & 1ULL){
+		  Transaction& data = projected[e - first];
+		  item.id = data.size();
+		  data.push_back(row);
+		  data.tidset.push_back(item);
+		}
+	  }
+	label++;
+      }
+}
+
+int run_out_of_core(const string& input_file, const MinerConfig& config, long budget, int case_order)
+{
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  if((config.method != 0) || (config.lamp_alpha != 0) || (config.wy_alpha != 0)){
+      cout<<"#error: -heuristics, -lamp and -wy are not mined out of core"<<endl;
+      return 1;
+    }
+  OutOfCoreScan scan;
+  if(!scan_matrix(input_file, config.min_case, config.max_control, case_order, scan)){
+      cout<<"#error: cannot read "<<input_file<<endl;
+      return 1;
+    }
+  int nb_case = scan.nb_case;
+  int nb_control = scan.nb_control;
+  int nb_registers = (nb_case + nb_bits - 1)/nb_bits + (nb_control + nb_bits - 1)/nb_bits;
+  long row_bytes = nb_registers*sizeof(__m256i) + sizeof(Tidset_vector) + sizeof(ITEM);
+
+  //the miner only holds the samples, the seeds are mined on their projected datasets
+  Transaction samples;
+  samples.nb_case = nb_case;
+  samples.nb_control = nb_control;
+  samples.nb_sample = nb_case + nb_control;
+  samples.case_registers = (nb_case + nb_bits - 1)/nb_bits;
+  samples.control_registers = (nb_control + nb_bits - 1)/nb_bits;
+  Miner miner(std::move(samples), config);
+
+  cout<<"#Exhaustive mining statistically significant discriminative patterns (out of core)"<<endl;
+  cout<<"#size of data: "<<scan.nb_items<<" x "<<nb_case + nb_control<<endl;
+  cout<<"#size of reduced data: "<<scan.nb_selected<<" x "<<nb_case + nb_control<<endl;
+  cout<<"#risk thresholds (OR, GR, DS): "<<config.or_threshold<<", "<<config.rr_threshold<<", "<<config.arr_threshold<<endl;
+  if(config.p_value!=0) cout<<"#p_value_threshold: "<<config.p_value<<endl;
+  cout<<"#min case support: "<<(config.min_case/nb_case)*100<<"%"<<endl;
+  cout<<"#max control support: "<<(config.max_control/nb_control)*100<<"%"<<endl;
+  cout<<"#min case output: "<<(config.min_case_out/nb_case)*100<<"%"<<endl;
+  cout<<endl<<"Output:"<<endl;
+  if(config.p_value!=0) cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) : p-value )"<<endl;
+  else cout<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
+
+  PatternSink sink = [&](const std::vector<int>& items, int a, int c){
+    print_pattern(cout, items, a, c, nb_case, nb_control, config.p_value, 0);
+  };
+  PhaseTimer mine_timer(PHASE_MINE);
+  //seeds as in Miner::mine: a pattern of seed e holds at most e+1 cases
+  int first_case = std::max(0, (int)config.min_case_out-1);
+  progress_pass(nb_case - first_case);
+  long nb_patterns = 0;
+  int nb_batches = 0;
+  for(int first=first_case; (first<nb_case) && !search_cancelled(); ){
+      //largest batch of seeds whose projected datasets fit in the budget (at least one seed)
+      int last = first;
+      long bytes = 0;
+      do {
+	bytes += scan.support[last]*row_bytes;
+	last++;
+      } while((last < nb_case) && (bytes + scan.support[last]*row_bytes <= budget));
+      std::vector<Transaction> projected;
+      project_seeds(input_file, scan, config.min_case, config.max_control, first, last, projected);
+      nb_batches++;
+      for(int e=first; (e<last) && !search_cancelled(); e++){
+	  nb_patterns += miner.mine_seed(e, projected[e - first], sink);
+	  Transaction().swap(projected[e - first]);
+	  progress_seed(e - first_case + 1);
+	}
+      first = last;
+    }
+  if(memory_exhausted){
+      cout<<"#memory limit reached: the output is partial"<<endl;
+      cout<<"#nb_patterns: "<<nb_patterns<<endl;
+      return 1;
+    }
+  cout<<endl<<"#nb_patterns "<<nb_patterns<<endl;
+  cout<<"#scans of the input: "<<nb_batches + 1<<endl;
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  cout<<"#running time "<<std::chrono::duration<float>(end-begin).count()<<" s"<<endl;
+  return 0;
+}
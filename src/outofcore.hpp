@@ -0,0 +1,71 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef OUTOFCORE_HPP_
+#define OUTOFCORE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "expand_avx.hpp"
+#include "miner.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////OUT-OF-CORE MINING/////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+The matrix file is not loaded. The exhaustive search of a seed e (a case, the
+largest case of the patterns it finds) only reads the items containing e, so
+each seed is mined on its own projected dataset. A 1st scan of the file
+selects the items and counts the items containing each case, then the seeds
+are taken in batches whose projected datasets fit in the budget: one scan of
+the file per batch builds the projected datasets of all its seeds, which are
+mined in order and freed. The patterns are those of the search of the loaded
+matrix, in the same order.
+ */
+struct OutOfCoreScan
+{
+  int nb_case;
+  int nb_control;
+  int nb_items;               //items of the file
+  int nb_selected;            //items selected by min_case and max_control
+  std::vector<int> perm;      //sample of each case position (order of -order-case)
+  std::vector<int> support;   //selected items containing the case of each position
+};
+
+//1st scan of a matrix file, return 0 if it cannot be read
+int scan_matrix(const string& file, float min_case, float max_control, int case_order, OutOfCoreScan& scan);
+
+//projected datasets of the seeds [first, last) from one scan of the file
+void project_seeds(const string& file, const OutOfCoreScan& scan, float min_case, float max_control, int first, int last, std::vector<Transaction>& projected);
+
+//mine input_file without loading it, the projected datasets of a batch of seeds taking at most budget bytes,
+//print the patterns like a run (exhaustive search without correction)
+int run_out_of_core(const string& input_file, const MinerConfig& config, long budget, int case_order);
+
+#endif /* OUTOFCORE_HPP_ */
@@ -0,0 +1,105 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+#include "parallel.hpp"
+
+using namespace std;
+
+static int nb_kernel_threads = 1;    //threads of the pool and calling thread
+
+//state of the pool, never destroyed: its threads wait on it until the end of the process
+struct KernelPool
+{
+  std::mutex busy;                    //held by the search whose kernel runs on the pool
+  std::mutex mutex;
+  std::condition_variable wakeup;     //a kernel has parts to compute
+  std::condition_variable done;       //all the parts of the kernel are computed
+  const std::function<void(int)>* task = nullptr;
+  int next_part = 0;   //next part of the kernel to compute
+  int nb_parts = 0;
+  int remaining = 0;   //parts of the kernel not computed yet
+};
+static KernelPool* pool = nullptr;
+
+//thread of the pool: compute the parts of the kernels
+static void compute_parts()
+{
+  std::unique_lock<std::mutex> lock(pool->mutex);
+  while(true){
+      pool->wakeup.wait(lock, []{ return pool->task && (pool->next_part < pool->nb_parts); });
+      int part = pool->next_part++;
+      const std::function<void(int)>& f = *pool->task;
+      lock.unlock();
+      f(part);
+      lock.lock();
+      if(--pool->remaining == 0) pool->done.notify_all();
+    }
+}
+
+void init_kernel_threads(int nb_threads)
+{
+  if(nb_threads <= 0) nb_threads = std::max(1u, std::thread::hardware_concurrency());
+  if(!pool) pool = new KernelPool;
+  for(int i=nb_kernel_threads; i<nb_threads; i++)
+    std::thread(compute_parts).detach();
+  nb_kernel_threads = std::max(nb_kernel_threads, nb_threads);
+}
+
+int kernel_parts(long work)
+{
+  if(work < kernel_min_work) return 1;
+  return (int)std::min((long)nb_kernel_threads, work / (kernel_min_work/2));
+}
+
+bool run_parts(int nb_parts, const std::function<void(int)>& f)
+{
+  if(!pool->busy.try_lock()) return false;
+  std::unique_lock<std::mutex> lock(pool->mutex);
+  pool->task = &f;
+  pool->next_part = 0;
+  pool->nb_parts = nb_parts;
+  pool->remaining = nb_parts;
+  pool->wakeup.notify_all();
+  //the calling thread computes parts too
+  while(pool->next_part < pool->nb_parts){
+      int part = pool->next_part++;
+      lock.unlock();
+      f(part);
+      lock.lock();
+      pool->remaining--;
+    }
+  pool->done.wait(lock, []{ return pool->remaining == 0; });
+  pool->task = nullptr;
+  lock.unlock();
+  pool->busy.unlock();
+  return true;
+}
@@ -0,0 +1,64 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+#include <functional>
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////THREADS OF THE KERNELS/////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+Near the root of the search of a dataset with many items, the time goes into
+the scans of the items by compute_tidlist_avx and compute_closure_avx, and
+there are too few seeds to search in parallel. Above kernel_min_work register
+operations, a kernel splits its items into parts: the threads of a pool and
+the calling thread compute the parts, each part in its own partial tidlist or
+tidset, and the calling thread merges them (the result is the one of the
+serial kernel). Below the threshold, or while the pool runs the kernel of
+another search, the kernel is serial. The threads of the pool never exit, so
+their thread_stats() would never be merged into -stats: the parts only scan
+the items, the counters and the tracked allocations are left to the calling
+thread.
+ */
+const long kernel_min_work = 1 << 16; //register operations of a kernel below which it is serial
+
+//start the pool: nb_threads threads compute the kernels with the calling thread
+//(1: serial kernels, 0: number of cores)
+void init_kernel_threads(int nb_threads);
+
+//number of parts of a kernel doing work register operations (1: serial)
+int kernel_parts(long work);
+
+//compute f(0), ..., f(nb_parts-1) on the pool and the calling thread,
+//return false without computing anything if the pool is used by another search
+//(f must not update the statistics or the memory of the thread, see above)
+bool run_parts(int nb_parts, const std::function<void(int)>& f);
+
+#endif /* PARALLEL_HPP_ */
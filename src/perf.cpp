@@ -0,0 +1,155 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "perf.hpp"
+
+using namespace std;
+
+thread_local bool perf_enabled = false;
+
+static const char* region_names[NB_PERF_REGIONS] = {"load", "filter", "mine", "compute_tidlist_avx", "compute_closure_avx", "reduced_dataset_avx", "scoring"};
+static const char* event_names[NB_PERF_EVENTS] = {"cycles", "instructions", "LLC-misses", "branch-misses"};
+static const unsigned long long event_configs[NB_PERF_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+static int event_fd[NB_PERF_EVENTS];
+static perf_event_mmap_page* event_page[NB_PERF_EVENTS]; //user page of the event for rdpmc
+static unsigned long long totals[NB_PERF_REGIONS][NB_PERF_EVENTS];
+static unsigned long long calls[NB_PERF_REGIONS];
+
+//read an event in user space, return false if rdpmc is not allowed
+static bool read_rdpmc(perf_event_mmap_page* pc, unsigned long long& value)
+{
+  unsigned int seq;
+  unsigned long long count;
+  do {
+    seq = pc->lock;
+    __sync_synchronize();
+    unsigned int index = pc->index;
+    if(!pc->cap_user_rdpmc || index == 0) return false;
+    count = pc->offset;
+    unsigned int low, high;
+    __asm__ volatile("rdpmc" : "=a"(low), "=d"(high) : "c"(index-1));
+    long long pmc = ((unsigned long long)high << 32) | low;
+    int shift = 64 - pc->pmc_width;
+    pmc = (pmc << shift) >> shift; //sign extension of the counter width
+    count += pmc;
+    __sync_synchronize();
+  } while(pc->lock != seq);
+  value = count;
+  return true;
+}
+
+//open the counters of the calling thread, return 0 if none is available
+int init_perf()
+{
+  int nb_open = 0;
+  for(int i=0; i<NB_PERF_EVENTS; i++){
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = event_configs[i];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      event_fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      event_page[i] = NULL;
+      if(event_fd[i] < 0){
+	  cerr<<"#perf: "<<event_names[i]<<" not available ("<<strerror(errno)<<")"<<endl;
+	  continue;
+	}
+      void* page = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED, event_fd[i], 0);
+      if(page != MAP_FAILED) event_page[i] = (perf_event_mmap_page*)page;
+      nb_open++;
+    }
+  perf_enabled = (nb_open > 0);
+  if(!perf_enabled) cerr<<"#perf: hardware counters not available, running without them"<<endl;
+  return perf_enabled;
+}
+
+//read the current value of all events (0 for the events not available)
+void read_perf(unsigned long long* values)
+{
+  for(int i=0; i<NB_PERF_EVENTS; i++){
+      values[i] = 0;
+      if(event_fd[i] < 0) continue;
+      if(event_page[i] && read_rdpmc(event_page[i], values[i])) continue;
+      if(read(event_fd[i], &values[i], sizeof(values[i])) != sizeof(values[i])) values[i] = 0;
+    }
+}
+
+//add the events since begin to a region
+void add_perf(int region, unsigned long long* begin)
+{
+  unsigned long long end[NB_PERF_EVENTS];
+  read_perf(end);
+  for(int i=0; i<NB_PERF_EVENTS; i++) totals[region][i] += end[i] - begin[i];
+  calls[region]++;
+}
+
+//print an event of a region, n/a if the event is not available
+static void print_event(std::ostream& out, int region, int event)
+{
+  if(event_fd[event] >= 0) out<<" : "<<totals[region][event];
+  else out<<" : n/a";
+}
+
+void print_perf(std::ostream& out)
+{
+  if(!perf_enabled) return;
+  out<<"#perf region : calls : cycles : instructions : IPC : LLC-misses : branch-misses"<<endl;
+  for(int r=0; r<NB_PERF_REGIONS; r++){
+      out<<"#perf "<<region_names[r]<<" : "<<calls[r];
+      print_event(out, r, PERF_CYCLES);
+      print_event(out, r, PERF_INSTRUCTIONS);
+      if((event_fd[PERF_CYCLES] >= 0) && (event_fd[PERF_INSTRUCTIONS] >= 0) && (totals[r][PERF_CYCLES] > 0))
+	out<<" : "<<(double)totals[r][PERF_INSTRUCTIONS]/totals[r][PERF_CYCLES];
+      else out<<" : n/a";
+      print_event(out, r, PERF_LLC_MISSES);
+      print_event(out, r, PERF_BRANCH_MISSES);
+      out<<endl;
+    }
+}
+
+//print the counters when the program exits
+static void print_perf_exit()
+{
+  print_perf(cout);
+}
+
+void print_perf_at_exit()
+{
+  atexit(print_perf_exit);
+}
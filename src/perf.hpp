@@ -0,0 +1,76 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#ifndef PERF_HPP_
+#define PERF_HPP_
+
+#include <iostream>
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////HARDWARE PERFORMANCE COUNTERS//////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+With -perf, cycles, instructions, LLC misses and branch mispredictions of the
+calling thread are read (perf_event_open) at the beginning and the end of
+the main phases and of the bitset kernels, and summed per region. Regions are
+inclusive: the kernels are also counted in the mining phase.
+The counters are read in user space (rdpmc) when the kernel allows it,
+otherwise with read(), which adds a system call to every kernel call.
+The counters belong to the thread that opened them (init_perf), the scopes
+of the other threads (server, stream, kernel pool) are not recorded.
+If the counters cannot be opened (no PMU, perf_event_paranoid, seccomp...)
+a message is printed and the program runs without them.
+ */
+enum PerfRegion { PERF_LOAD, PERF_FILTER, PERF_MINE, PERF_TIDLIST, PERF_CLOSURE, PERF_REDUCED, PERF_SCORE, NB_PERF_REGIONS };
+enum PerfEvent { PERF_CYCLES, PERF_INSTRUCTIONS, PERF_LLC_MISSES, PERF_BRANCH_MISSES, NB_PERF_EVENTS };
+
+extern thread_local bool perf_enabled; //true on the thread that opened the counters
+
+int init_perf();
+void read_perf(unsigned long long* values);
+void add_perf(int region, unsigned long long* begin);
+void print_perf(std::ostream& out);
+void print_perf_at_exit();
+
+//count the events of a region until the end of the scope
+struct PerfScope
+{
+  int region;
+  unsigned long long begin[NB_PERF_EVENTS];
+  PerfScope(int r) : region(r) { if(perf_enabled) read_perf(begin); }
+  void stop() {
+    if(region < 0) return;
+    if(perf_enabled) add_perf(region, begin);
+    region = -1;
+  }
+  ~PerfScope() { stop(); }
+};
+
+#endif /* PERF_HPP_ */
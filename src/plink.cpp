@@ -0,0 +1,225 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+#include <immintrin.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "plink.hpp"
+#include "loader.hpp"
+#include "stats.hpp"
+#include "perf.hpp"
+
+using namespace std;
+
+static const unsigned char bed_magic[3] = {0x6c, 0x1b, 0x01}; //SNP-major .bed
+
+static string plink_prefix(const string& file)
+{
+  return file.substr(0, file.size() - 4);
+}
+
+int is_plink_file(const string& file)
+{
+  return (file.size() > 4) && (file.compare(file.size() - 4, 4, ".bed") == 0);
+}
+
+//column of each sample of the .fam in the matrix (cases first, -1: left out)
+static int read_fam(const string& file, std::vector<int>& column, int& nb_case, int& nb_control)
+{
+  ifstream fam ((plink_prefix(file) + ".fam").c_str(), ifstream::in);
+  if(!fam) return false;
+  std::vector<int> label;
+  string line;
+  while(getline(fam,line)){
+      if(line.empty()) continue;
+      stringstream ss(line);
+      string fid, iid, pat, mat, sex, pheno;
+      if(!(ss>>fid>>iid>>pat>>mat>>sex>>pheno)) return false;
+      if(pheno=="2") label.push_back(1);
+      else if(pheno=="1") label.push_back(0);
+      else label.push_back(-1);
+    }
+  nb_case = 0;
+  nb_control = 0;
+  for(int s=0; s<label.size(); s++){
+      if(label[s]==1) nb_case++;
+      if(label[s]==0) nb_control++;
+    }
+  column.assign(label.size(), -1);
+  int next_case = 0;
+  int next_control = nb_case;
+  for(int s=0; s<label.size(); s++){
+      if(label[s]==1) column[s] = next_case++;
+      if(label[s]==0) column[s] = next_control++;
+    }
+  return true;
+}
+
+int read_plink_header(const string& file, int& nb_case, int& nb_control)
+{
+  std::vector<int> column;
+  return read_fam(file, column, nb_case, nb_control);
+}
+
+//samples of the 4 genotypes of a .bed byte in each item of a SNP (bit k: k-th genotype)
+//codes: 00 two A1, 01 missing, 10 one A1 and one A2, 11 two A2
+struct GenotypeTables
+{
+  unsigned char one_a1[256];  //at least one A1
+  unsigned char two_a1[256];  //two A1
+  unsigned char one_a2[256];  //at least one A2
+
+  GenotypeTables(){
+    for(int b=0; b<256; b++){
+	one_a1[b] = two_a1[b] = one_a2[b] = 0;
+	for(int k=0; k<4; k++){
+	    int g = (b >> (2*k)) & 3;
+	    if((g==0) || (g==2)) one_a1[b] |= 1 << k;
+	    if(g==0) two_a1[b] |= 1 << k;
+	    if((g==2) || (g==3)) one_a2[b] |= 1 << k;
+	  }
+      }
+  }
+};
+static const GenotypeTables genotype_tables;
+
+//unpack the genotypes of a SNP into the row of one item, count its cases a and controls c
+static void unpack_snp(const std::vector<unsigned char>& bytes, const unsigned char* table, const std::vector<int>& position,
+		       int case_bits, Tidset_vector& row, int& a, int& c)
+{
+  unsigned long long* f = (unsigned long long*)&row[0];
+  a = 0;
+  c = 0;
+  for(int k=0; k<bytes.size(); k++){
+      unsigned int m = table[bytes[k]];
+      while(m){
+	  int pos = position[4*k + __builtin_ctz(m)];
+	  m &= m - 1;
+	  if(pos < 0) continue;
+	  f[pos >> 6] |= (1ULL << (pos & 63));
+	  if(pos < case_bits) a++;
+	  else c++;
+	}
+    }
+}
+
+int load_plink(const string& file, int encoding, float min_case, float max_control, int case_order, int item_order,
+	       Transaction& transaction, int& nb_items, std::vector<string>& names, string& error)
+{
+  PhaseTimer load_timer(PHASE_LOAD);
+  PerfScope load_perf(PERF_LOAD);
+  string prefix = plink_prefix(file);
+  int nb_case = 0;
+  int nb_control = 0;
+  std::vector<int> column;
+  if(!read_fam(file, column, nb_case, nb_control)){
+      error = "cannot read " + prefix + ".fam";
+      return false;
+    }
+  int case_registers = (nb_case + nb_bits - 1) / nb_bits;
+  int control_registers = (nb_control + nb_bits - 1) / nb_bits;
+  int nb_registers = case_registers + control_registers;
+  //bit of each sample in the rows (4 per byte, padded to the last byte)
+  int nb_fam = column.size();
+  int row_bytes = (nb_fam + 3) / 4;
+  std::vector<int> position(4*row_bytes, -1);
+  for(int s=0; s<nb_fam; s++)
+    if(column[s] >= 0) position[s] = (column[s] < nb_case) ? column[s] : case_registers*nb_bits + (column[s] - nb_case);
+
+  //SNP ids and alleles
+  ifstream bim ((prefix + ".bim").c_str(), ifstream::in);
+  if(!bim){
+      error = "cannot read " + prefix + ".bim";
+      return false;
+    }
+  std::vector<string> snp_names;
+  string line;
+  while(getline(bim,line)){
+      if(line.empty()) continue;
+      stringstream ss(line);
+      string chr, id, cm, bp, a1, a2;
+      if(!(ss>>chr>>id>>cm>>bp>>a1>>a2)){
+	  error = "invalid line in " + prefix + ".bim: " + line;
+	  return false;
+	}
+      if(encoding == GENOTYPE_ALLELE){
+	  snp_names.push_back(id + ":" + a1);
+	  snp_names.push_back(id + ":" + a2);
+	} else
+	snp_names.push_back(id);
+    }
+  int nb_snps = (encoding == GENOTYPE_ALLELE) ? snp_names.size()/2 : snp_names.size();
+
+  ifstream bed ((prefix + ".bed").c_str(), ifstream::in | ifstream::binary);
+  unsigned char magic[3];
+  if(!bed || !bed.read((char*)magic, 3) || !std::equal(magic, magic + 3, bed_magic)){
+      error = "not a SNP-major PLINK .bed: " + prefix + ".bed";
+      return false;
+    }
+
+  //select the items of each SNP by their supports
+  std::vector<const unsigned char*> tables;
+  if(encoding == GENOTYPE_DOMINANT) tables.push_back(genotype_tables.one_a1);
+  if(encoding == GENOTYPE_RECESSIVE) tables.push_back(genotype_tables.two_a1);
+  if(encoding == GENOTYPE_ALLELE){
+      tables.push_back(genotype_tables.one_a1);
+      tables.push_back(genotype_tables.one_a2);
+    }
+  std::vector<Tidset_vector> rows;
+  std::vector<int> labels;
+  std::vector<unsigned char> bytes(row_bytes);
+  nb_items = 0;
+  for(int snp=0; snp<nb_snps; snp++){
+      if(!bed.read((char*)&bytes[0], row_bytes)){
+	  error = "truncated " + prefix + ".bed (" + std::to_string(snp) + " of " + std::to_string(nb_snps) + " SNPs)";
+	  return false;
+	}
+      for(int t=0; t<tables.size(); t++){
+	  Tidset_vector row(nb_registers, _mm256_setzero_si256());
+	  int a = 0;
+	  int c = 0;
+	  unpack_snp(bytes, tables[t], position, case_registers*nb_bits, row, a, c);
+	  if( ((max_control < 0) || (c <= max_control)) && (a >= min_case) ){
+	      rows.push_back(std::move(row));
+	      labels.push_back(nb_items);
+	    }
+	  nb_items++;
+	}
+    }
+  load_timer.stop();
+  load_perf.stop();
+  transaction = pack_bitrows(rows, labels, nb_case, nb_control, case_order, item_order);
+  names.swap(snp_names);
+  return true;
+}
@@ -0,0 +1,62 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef PLINK_HPP_
+#define PLINK_HPP_
+
+#include <string>
+#include <vector>
+
+#include "expand_avx.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////LOADING OF PLINK BINARY GENOTYPES//////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+A PLINK fileset X.bed, X.bim, X.fam is read instead of a matrix when the
+input file ends with .bed. The .fam phenotype gives the class of the samples
+(2: case, 1: control, other values: the sample is left out), the samples keep
+their order in each class. Each SNP of the .bim gives items by the encoding
+of its genotypes (A1: 1st allele of the .bim, usually the minor allele):
+dominant: at least one A1, recessive: two A1, allele: one item per allele
+carried. Missing genotypes are in no item. The 2-bit codes of the .bed
+(SNP-major) are unpacked by tables straight into the rows, which are
+selected and reordered like the lines of a matrix. Items keep their number
+(SNP order, then allele order) as label and the .bim id as name.
+ */
+enum { GENOTYPE_DOMINANT = 0, GENOTYPE_RECESSIVE = 1, GENOTYPE_ALLELE = 2 };
+
+int is_plink_file(const string& file);
+//number of cases and controls of the .fam, return false if it cannot be read
+int read_plink_header(const string& file, int& nb_case, int& nb_control);
+//load a PLINK fileset, nb_items is the number of items before the selection, names the name of each label
+//return false and an error message if the fileset cannot be read
+int load_plink(const string& file, int encoding, float min_case, float max_control, int case_order, int item_order,
+	       Transaction& transaction, int& nb_items, std::vector<string>& names, string& error);
+
+#endif /* PLINK_HPP_ */
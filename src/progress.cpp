@@ -0,0 +1,157 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include "progress.hpp"
+
+using namespace std;
+
+Progress progress;
+bool progress_enabled = false;
+
+//counters of the running threads, and counts of the finished ones
+static std::mutex counters_mutex;
+static std::vector<ProgressCounters*> running_counters;
+static long finished_nodes = 0;
+static long finished_patterns = 0;
+
+ProgressCounters::ProgressCounters() : nodes(0), patterns(0), depth(0)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  running_counters.push_back(this);
+}
+
+ProgressCounters::~ProgressCounters()
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  finished_nodes += nodes.load(std::memory_order_relaxed);
+  finished_patterns += patterns.load(std::memory_order_relaxed);
+  running_counters.erase(std::find(running_counters.begin(), running_counters.end(), this));
+}
+
+static thread_local ProgressCounters local_progress;
+
+ProgressCounters& thread_progress()
+{
+  return local_progress;
+}
+
+//sum of the counters of all threads, depth of the deepest running search
+static void sum_counters(long& nodes, long& patterns, int& depth)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  nodes = finished_nodes;
+  patterns = finished_patterns;
+  depth = 0;
+  for(int i=0; i<running_counters.size(); i++){
+      nodes += running_counters[i]->nodes.load(std::memory_order_relaxed);
+      patterns += running_counters[i]->patterns.load(std::memory_order_relaxed);
+      depth = std::max(depth, running_counters[i]->depth.load(std::memory_order_relaxed));
+    }
+}
+
+static std::thread reporter;
+static std::mutex reporter_mutex;
+static std::condition_variable reporter_wakeup;
+static bool reporter_stop = false;
+
+static long now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//start a pass of nb_seeds top-level seeds (the ETA is computed per pass)
+void progress_pass(int nb_seeds)
+{
+  progress.seed.store(0, std::memory_order_relaxed);
+  progress.nb_seeds.store(nb_seeds, std::memory_order_relaxed);
+  progress.pass_start.store(now_ns(), std::memory_order_relaxed);
+}
+
+//print a progress line every interval seconds until stop_progress
+static void report_progress(float interval, std::string status_file)
+{
+  long last_time = now_ns();
+  long last_nodes = 0;
+  long last_patterns = 0;
+  std::unique_lock<std::mutex> lock(reporter_mutex);
+  while(!reporter_wakeup.wait_for(lock, std::chrono::duration<float>(interval), []{ return reporter_stop; })){
+      long time = now_ns();
+      long nodes = 0;
+      long patterns = 0;
+      int depth = 0;
+      sum_counters(nodes, patterns, depth);
+      int seed = progress.seed.load(std::memory_order_relaxed);
+      int nb_seeds = progress.nb_seeds.load(std::memory_order_relaxed);
+      double seconds = (time - last_time)*1e-9;
+      double elapsed = (time - progress.pass_start.load(std::memory_order_relaxed))*1e-9;
+
+      std::ofstream file;
+      if(!status_file.empty()) file.open(status_file.c_str(), ofstream::out | ofstream::trunc);
+      std::ostream& out = status_file.empty() ? cerr : file;
+      out<<"#progress seed "<<seed<<"/"<<nb_seeds
+	 <<" nodes "<<nodes<<" ("<<(long)((nodes-last_nodes)/seconds)<<"/s)"
+	 <<" patterns "<<patterns<<" ("<<(long)((patterns-last_patterns)/seconds)<<"/s)"
+	 <<" depth "<<depth;
+      //average cost of the finished seeds
+      if(seed > 0) out<<" eta "<<elapsed/seed*(nb_seeds-seed)<<" s";
+      else out<<" eta ?";
+      out<<endl;
+
+      last_time = time;
+      last_nodes = nodes;
+      last_patterns = patterns;
+    }
+}
+
+//start the background reporter, it is stopped at exit if stop_progress is not called
+void start_progress(float interval, const std::string& status_file)
+{
+  progress_enabled = true;
+  progress_pass(0);
+  reporter_stop = false;
+  reporter = std::thread(report_progress, interval, status_file);
+  atexit(stop_progress);
+}
+
+void stop_progress()
+{
+  {
+    std::lock_guard<std::mutex> lock(reporter_mutex);
+    reporter_stop = true;
+  }
+  reporter_wakeup.notify_all();
+  if(reporter.joinable()) reporter.join();
+}
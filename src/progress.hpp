@@ -0,0 +1,95 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#ifndef PROGRESS_HPP_
+#define PROGRESS_HPP_
+
+#include <atomic>
+#include <string>
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////PROGRESS REPORTING/////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+Each search thread updates its own counters with relaxed atomics; a
+background thread sums the counters of all threads every interval and prints
+the progress (seed, nodes/s, patterns/s, depth, ETA) to the error output or
+to a status file. A thread is the single writer of its counters, so an update
+is a plain load and store, no locked instruction and no cache line shared
+with the other threads. Nothing is counted when the reporting is not started.
+ */
+struct ProgressCounters
+{
+  std::atomic<long> nodes;     //visited nodes
+  std::atomic<long> patterns;  //reported patterns
+  std::atomic<int> depth;      //depth of the last visited node
+
+  ProgressCounters();          //registered for the reporter
+  ~ProgressCounters();         //the counts of a finished thread are kept
+};
+
+struct Progress
+{
+  std::atomic<int> seed;       //number of finished top-level seeds
+  std::atomic<int> nb_seeds;   //number of top-level seeds of the current pass
+  std::atomic<long> pass_start; //steady clock (ns) of the beginning of the current pass
+};
+
+extern Progress progress;
+extern bool progress_enabled;  //set by start_progress before the search
+
+ProgressCounters& thread_progress(); //counters of the calling thread
+
+inline void progress_node(int depth)
+{
+  if(!progress_enabled) return;
+  ProgressCounters& p = thread_progress();
+  p.nodes.store(p.nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  p.depth.store(depth, std::memory_order_relaxed);
+}
+
+inline void progress_pattern()
+{
+  if(!progress_enabled) return;
+  ProgressCounters& p = thread_progress();
+  p.patterns.store(p.patterns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+inline void progress_seed(int seed)
+{
+  if(!progress_enabled) return;
+  progress.seed.store(seed, std::memory_order_relaxed);
+}
+
+void progress_pass(int nb_seeds);
+void start_progress(float interval, const std::string& status_file);
+void stop_progress();
+
+#endif /* PROGRESS_HPP_ */
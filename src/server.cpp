@@ -0,0 +1,263 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "server.hpp"
+#include "cancel.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+const int send_buffer_size = 1 << 16; //patterns are sent by blocks of 64KB
+
+static std::mutex queue_mutex;
+static std::condition_variable queue_wakeup;
+static std::deque<int> connections; //accepted connections waiting for a thread
+static char served_path[sizeof(((sockaddr_un*)0)->sun_path)];
+
+//remove the socket file when the server is stopped
+static void stop_server(int)
+{
+  unlink(served_path);
+  _exit(0);
+}
+
+//send all bytes of data, return 0 if the client is gone
+static int send_all(int fd, const string& data)
+{
+  size_t sent = 0;
+  while(sent < data.size()){
+      ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if(n < 0 && errno == EINTR) continue;
+      if(n <= 0) return 0;
+      sent += n;
+    }
+  return 1;
+}
+
+int parse_query(const string& query, MinerConfig& config, int nb_case, int nb_control, string& error)
+{
+  std::vector<string> options;
+  stringstream ss(query);
+  string tok;
+  while(ss >> tok) options.push_back(tok);
+
+  for(int i=0; i<options.size(); i++){
+      const char* option = options[i].c_str();
+      //options without value
+      if(options[i]=="-heuristics"){
+	  config.method = 1;
+	  continue;
+	}
+      if(i+1 >= options.size()){
+	  error = "parameter of " + options[i] + " is invalid";
+	  return 0;
+	}
+      char* end;
+      float temp = strtof(options[i+1].c_str(), &end);
+      int valid = (*end == '\0');
+      switch(str2int(option)){
+	case str2int("-or"):
+	  valid = valid && (temp!=0);
+	  if(valid) config.or_threshold = temp;
+	  break;
+	case str2int("-gr"):
+	  valid = valid && (temp!=0);
+	  if(valid) config.rr_threshold = temp;
+	  break;
+	case str2int("-ds"):
+	  valid = valid && (temp!=0);
+	  if(valid) config.arr_threshold = temp;
+	  break;
+	case str2int("-pval"):
+	case str2int("-p-value"):
+	  valid = valid && (temp>0) && (temp<=1);
+	  if(valid) config.p_value = temp;
+	  break;
+	case str2int("-lamp"):
+	  valid = valid && (temp>0) && (temp<=1);
+	  if(valid) config.lamp_alpha = temp;
+	  break;
+	case str2int("-wy"):
+	  valid = valid && (temp>0) && (temp<=1);
+	  if(valid) config.wy_alpha = temp;
+	  break;
+	case str2int("-perm"):
+	  valid = valid && (temp>=1);
+	  if(valid) config.nb_permutations = temp;
+	  break;
+	case str2int("-seed"):
+	  valid = valid && (temp>=0);
+	  if(valid) config.seed = temp;
+	  break;
+	case str2int("-min"):
+	  valid = valid && (temp!=0);
+	  if(valid){
+	      config.min_case = temp*nb_case;
+	      config.min_case_out = config.min_case;
+	    }
+	  break;
+	case str2int("-max"):
+	  valid = valid && (temp!=0);
+	  if(valid) config.max_control = temp*nb_control;
+	  break;
+	case str2int("-iteration"):
+	  valid = valid && (temp!=0);
+	  if(valid) config.it_threshold = temp*1000000;
+	  break;
+	default:
+	  error = "unknown option " + options[i];
+	  return 0;
+	}
+      if(!valid){
+	  error = "parameter of " + options[i] + " is invalid";
+	  return 0;
+	}
+      i++;
+    }
+  return 1;
+}
+
+//mine a query and stream its patterns to the client
+//the search is cancelled if the client is gone
+static void answer_query(int fd, const string& query, Transaction& transaction)
+{
+  MinerConfig config;
+  string error;
+  if(!parse_query(query, config, transaction.nb_case, transaction.nb_control, error)){
+      send_all(fd, "#error: " + error + "\n");
+      return;
+    }
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  Miner miner(transaction, config);
+  CancelToken token;
+  std::ostringstream out;
+  long nb_patterns = miner.mine([&](const std::vector<int>& items, int a, int c){
+      //the p-value threshold is the corrected level after the 1st pass of LAMP or Westfall-Young
+      print_pattern(out, items, a, c, transaction.nb_case, transaction.nb_control, miner.config.p_value, config.method);
+      if(out.tellp() >= send_buffer_size){
+	  if(!send_all(fd, out.str())) token.cancel();
+	  out.str("");
+	}
+    }, &token);
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  out<<"#nb_patterns "<<nb_patterns<<endl;
+  out<<"#running time "<<std::chrono::duration<float>(end-begin).count()<<" s"<<endl;
+  send_all(fd, out.str());
+}
+
+//thread of the pool: answer the queries of one connection at a time
+static void serve_connections(Transaction& transaction)
+{
+  while(true){
+      int fd;
+      {
+	std::unique_lock<std::mutex> lock(queue_mutex);
+	queue_wakeup.wait(lock, []{ return !connections.empty(); });
+	fd = connections.front();
+	connections.pop_front();
+      }
+      string pending;
+      char buffer[4096];
+      ssize_t n;
+      while((n = recv(fd, buffer, sizeof(buffer), 0)) != 0){
+	  if(n < 0){
+	      if(errno == EINTR) continue;
+	      break;
+	    }
+	  pending.append(buffer, n);
+	  size_t eol;
+	  while((eol = pending.find('\n')) != string::npos){
+	      string query = pending.substr(0, eol);
+	      pending.erase(0, eol+1);
+	      answer_query(fd, query, transaction);
+	    }
+	}
+      close(fd);
+    }
+}
+
+int serve(const string& socket_path, Transaction& transaction, int nb_threads)
+{
+  if(socket_path.size() >= sizeof(served_path)){
+      cerr<<"socket path "<<socket_path<<" is too long"<<endl;
+      return 1;
+    }
+  strcpy(served_path, socket_path.c_str());
+  int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, served_path);
+  unlink(served_path);
+  if((server_fd < 0) || (bind(server_fd, (sockaddr*)&address, sizeof(address)) < 0) || (listen(server_fd, 64) < 0)){
+      cerr<<"cannot listen on "<<socket_path<<": "<<strerror(errno)<<endl;
+      return 1;
+    }
+  signal(SIGINT, stop_server);
+  signal(SIGTERM, stop_server);
+  signal(SIGPIPE, SIG_IGN);
+
+  //the tables of Fisher's exact test are built once, the miners of the queries share them
+  std::shared_ptr<const FisherTable> fisher = get_fisher_table(transaction.nb_case, transaction.nb_control);
+  if(nb_threads <= 0) nb_threads = std::max(1u, std::thread::hardware_concurrency());
+  for(int i=0; i<nb_threads; i++)
+    std::thread(serve_connections, std::ref(transaction)).detach();
+  cout<<"#serving "<<transaction.size()<<" x "<<transaction.nb_sample<<" on "<<socket_path<<" ("<<nb_threads<<" threads)"<<endl;
+
+  while(true){
+      int fd = accept(server_fd, NULL, NULL);
+      if(fd < 0){
+	  if(errno == EINTR) continue;
+	  cerr<<"accept failed: "<<strerror(errno)<<endl;
+	  break;
+	}
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      connections.push_back(fd);
+      queue_wakeup.notify_one();
+    }
+  close(server_fd);
+  unlink(served_path);
+  return 1;
+}
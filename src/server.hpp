@@ -0,0 +1,59 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef SERVER_HPP_
+#define SERVER_HPP_
+
+#include <string>
+
+#include "miner.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////RESIDENT SERVER////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+The dataset is loaded once and queries are answered over a Unix domain
+socket. A query is one line of mining options (-or, -gr, -ds, -pval, -min,
+-max, -heuristics, -iteration, -lamp, -wy, -perm, -seed); the patterns are
+written back as they are found, followed by "#nb_patterns n" and
+"#running time t s". A connection can send several queries.
+Connections are served by a pool of threads; each query mines its own copy
+of the selected items, the loaded dataset is only read.
+ */
+
+//parse a query into a configuration, return 0 and set error if an option is invalid
+int parse_query(const string& query, MinerConfig& config, int nb_case, int nb_control, string& error);
+
+//listen on socket_path and answer queries until the process is killed, return 1 on error
+int serve(const string& socket_path, Transaction& transaction, int nb_threads);
+
+#endif /* SERVER_HPP_ */
@@ -0,0 +1,148 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <immintrin.h>
+
+#include "significance.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+//init LAMP: minimal attainable p-values for all supports (the tables of the dataset must be installed by a FisherScope)
+void init_lamp(Significance& sig, float alpha, int nb_case, int nb_control)
+{
+  int n = nb_case + nb_control;
+  sig.mode = 1;
+  sig.alpha = alpha;
+  sig.nb_case = nb_case;
+  sig.psi.assign(n+1, 1);
+  for(int x=0; x<=n; x++){
+      int a = std::min(x, nb_case);
+      sig.psi[x] = fisher_pvalue(a, x-a);
+    }
+  sig.levels = sig.psi;
+  std::sort(sig.levels.begin(), sig.levels.end());
+  sig.levels.erase(std::unique(sig.levels.begin(), sig.levels.end()), sig.levels.end());
+  sig.nb_testable.assign(n+1, 0);
+  sig.k = 0;
+  sig.nb_pruning = 0;
+
+  //start from the largest level <= alpha (nothing counted yet)
+  sig.level = std::upper_bound(sig.levels.begin(), sig.levels.end(), (double)alpha) - sig.levels.begin() - 1;
+  sig.delta = (sig.level >= 0) ? sig.levels[sig.level] : 0;
+}
+
+//check if a pattern of support in [min_support, max_support] can be testable
+//psi decreases until the number of cases then increases, its minimum is at the closest support to nb_case
+int check_testable(Significance& sig, int min_support, int max_support)
+{
+  if(sig.mode == 0) return true;
+  int x = std::min(std::max(sig.nb_case, min_support), max_support);
+  if(sig.psi[x] <= sig.delta) return true;
+  sig.nb_pruning++;
+  return false;
+}
+
+//count a closed pattern of a given support and lower the level until k*delta <= alpha
+void count_testable(Significance& sig, int support)
+{
+  if(sig.psi[support] > sig.delta) return;
+  sig.nb_testable[support]++;
+  sig.k++;
+  while(sig.level >= 0 && sig.k*sig.delta > sig.alpha){
+      //remove the patterns which are not testable at the next level
+      for(int x=0; x<sig.psi.size(); x++)
+	if(sig.psi[x] == sig.levels[sig.level]) sig.k -= sig.nb_testable[x];
+      sig.level--;
+      sig.delta = (sig.level >= 0) ? sig.levels[sig.level] : 0;
+    }
+}
+
+//init Westfall-Young permutations (the tables of the dataset must be installed by a FisherScope)
+void init_westfall_young(Significance& sig, float alpha, int nb_permutations, unsigned int seed, int nb_case, int nb_control)
+{
+  init_lamp(sig, alpha, nb_case, nb_control);
+  sig.mode = 3;
+  sig.delta = 1;
+  sig.min_pvalue.assign(nb_permutations, 1);
+  sig.quantile = std::min((int)(alpha*nb_permutations), nb_permutations-1);
+
+  int nb_sample = nb_case + nb_control;
+  int nb_registers = (nb_sample + nb_bits - 1)/nb_bits;
+  std::vector<int> tids(nb_sample);
+  for(int i=0; i<nb_sample; i++) tids[i] = i;
+  std::mt19937 generator(seed);
+  sig.permutations.clear();
+  for(int j=0; j<nb_permutations; j++){
+      std::shuffle(tids.begin(), tids.end(), generator);
+      Tidset_vector mask(nb_registers, _mm256_setzero_si256());
+      for(int i=0; i<nb_case; i++)
+	SetBit(mask[tids[i]/nb_bits], tids[i]%nb_bits, true);
+      sig.permutations.push_back(mask);
+    }
+}
+
+//update the smallest p-value of all permutations with a closed tidset p
+//the number of cases of permutation j is the size of p & permutations[j]
+void count_permutations(Significance& sig, Tidset_vector& p)
+{
+  int x = get_size(p);
+  if(sig.psi[x] >= sig.delta) return;
+  int update = 0;
+  for(int j=0; j<sig.permutations.size(); j++){
+      Tidset_vector& mask = sig.permutations[j];
+      int a = 0;
+      for(int i=0; i<p.size(); i++){
+	  __m256i t = _mm256_and_si256(p[i], mask[i]);
+	  a += _mm_popcnt_u64(_mm256_extract_epi64(t,0)) + _mm_popcnt_u64(_mm256_extract_epi64(t,1))
+	     + _mm_popcnt_u64(_mm256_extract_epi64(t,2)) + _mm_popcnt_u64(_mm256_extract_epi64(t,3));
+	}
+      double pvalue = fisher_pvalue(a, x-a);
+      if(pvalue < sig.min_pvalue[j]){
+	  //the quantile only moves if a value crosses it
+	  if(sig.min_pvalue[j] >= sig.delta && pvalue < sig.delta) update = 1;
+	  sig.min_pvalue[j] = pvalue;
+	}
+    }
+  if(update){
+      std::vector<double> tmp = sig.min_pvalue;
+      std::nth_element(tmp.begin(), tmp.begin()+sig.quantile, tmp.end());
+      sig.delta = tmp[sig.quantile];
+    }
+}
+
+//largest float threshold below a level (strictly below if strict)
+//p-value thresholds are float, a rounded level could accept larger p-values
+float float_threshold(double level, int strict)
+{
+  float result = (float)level;
+  while( (result > 0) && (strict ? ((double)result >= level) : ((double)result > level)) )
+    result = std::nextafter(result, 0.0f);
+  return result;
+}
@@ -0,0 +1,89 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef SIGNIFICANCE_HPP_
+#define SIGNIFICANCE_HPP_
+
+#include <iostream>
+#include <vector>
+
+#include "utils.hpp"
+#include "expand_avx.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////MULTIPLE TESTING CORRECTION (TARONE / LAMP)////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+A pattern of support x (cases + controls) cannot reach a p-value smaller than
+psi[x], the p-value of the table putting as many of its x samples as possible
+in the 1st class. It is testable at level delta if psi[x] <= delta.
+LAMP looks for the largest level delta such that k(delta)*delta <= alpha, where
+k(delta) is the number of testable patterns: the family-wise error rate of the
+patterns whose p-value is <= delta is then bounded by alpha.
+The level is lowered while patterns are counted, and the subtrees where no
+pattern can be testable are pruned.
+
+Westfall-Young permutations: the 1st class is drawn at random among the tids
+for each permutation j and the smallest p-value min_pvalue[j] of all closed
+patterns is tracked. The corrected level is the alpha-quantile of min_pvalue,
+patterns are significant if their p-value is strictly smaller. The closed
+patterns do not depend on the classes, so a single enumeration (on a dataset
+where all tids are in the 1st class) computes the supports of all
+permutations at each pattern. As for LAMP, the subtrees whose p-values cannot
+be smaller than the current quantile are pruned.
+ */
+struct Significance
+{
+  int mode;                       //0: not used, 1: counting testable patterns, 2: mining with the corrected level, 3: permutations
+  float alpha;                    //family-wise error rate
+  int nb_case;                    //support of the smallest psi
+  std::vector<double> psi;        //minimal attainable p-value of a pattern of support x
+  std::vector<double> levels;     //distinct values of psi, in increasing order
+  std::vector<long> nb_testable;  //number of counted patterns of support x
+  int level;                      //index of the current level in levels
+  long k;                         //number of counted patterns with psi <= delta
+  double delta;                   //current corrected significance level
+  long nb_pruning;                //number of untestable subtrees pruned
+  std::vector<Tidset_vector> permutations; //1st class of each permutation (tid i at bit i)
+  std::vector<double> min_pvalue; //smallest p-value of each permutation
+  int quantile;                   //rank of the alpha-quantile in min_pvalue
+
+  Significance() : mode(0), alpha(0), nb_case(0), level(0), k(0), delta(1), nb_pruning(0), quantile(0) {}
+};
+
+//patterns are counted, not output
+inline int counting_pass(Significance& sig) { return (sig.mode == 1) || (sig.mode == 3); }
+
+void init_lamp(Significance& sig, float alpha, int nb_case, int nb_control);
+int check_testable(Significance& sig, int min_support, int max_support);
+void count_testable(Significance& sig, int support);
+void init_westfall_young(Significance& sig, float alpha, int nb_permutations, unsigned int seed, int nb_case, int nb_control);
+void count_permutations(Significance& sig, Tidset_vector& p);
+float float_threshold(double level, int strict);
+
+#endif /* SIGNIFICANCE_HPP_ */
@@ -0,0 +1,155 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <stdlib.h>
+
+#include "stats.hpp"
+
+using namespace std;
+
+static const char* phase_names[NB_PHASES] = {"load", "filter", "mine", "output"};
+static const char* prune_names[NB_PRUNES] = {"tidlist", "score", "ppc", "closure", "testable", "predict"};
+
+Stats::Stats() : nb_tidlist(0), nb_closure(0), nb_reduced(0), reduced_items(0), max_reduced_items(0), peak_memory(0), depth(0)
+{
+  for(int i=0; i<NB_PRUNES; i++) prunes[i] = 0;
+  for(int i=0; i<NB_PHASES; i++) seconds[i] = 0;
+}
+
+//sum the counters of another Stats
+void Stats::add(const Stats& s)
+{
+  if(nodes.size() < s.nodes.size()) nodes.resize(s.nodes.size(), 0);
+  for(int i=0; i<s.nodes.size(); i++) nodes[i] += s.nodes[i];
+  nb_tidlist += s.nb_tidlist;
+  nb_closure += s.nb_closure;
+  nb_reduced += s.nb_reduced;
+  reduced_items += s.reduced_items;
+  max_reduced_items = std::max(max_reduced_items, s.max_reduced_items);
+  for(int i=0; i<NB_PRUNES; i++) prunes[i] += s.prunes[i];
+  for(int i=0; i<NB_PHASES; i++) seconds[i] += s.seconds[i];
+  if(memory.size() < s.memory.size()) memory.resize(s.memory.size(), 0);
+  for(int i=0; i<s.memory.size(); i++) memory[i] = std::max(memory[i], s.memory[i]);
+  peak_memory = std::max(peak_memory, s.peak_memory);
+}
+
+//counters of the finished threads
+static std::mutex finished_mutex;
+static Stats finished_stats;
+
+//counters of a thread, added to the finished counters when the thread ends
+struct ThreadStats
+{
+  Stats stats;
+  ~ThreadStats() {
+    stats.peak_memory = thread_memory.peak;
+    std::lock_guard<std::mutex> lock(finished_mutex);
+    finished_stats.add(stats);
+  }
+};
+
+static thread_local ThreadStats local_stats;
+
+Stats& thread_stats()
+{
+  return local_stats.stats;
+}
+
+//counters of the finished threads and of the calling thread
+Stats collect_stats()
+{
+  std::lock_guard<std::mutex> lock(finished_mutex);
+  Stats result = finished_stats;
+  local_stats.stats.peak_memory = thread_memory.peak;
+  result.add(local_stats.stats);
+  return result;
+}
+
+void print_stats_json(std::ostream& out, const Stats& s)
+{
+  long nb_nodes = 0;
+  for(int i=0; i<s.nodes.size(); i++) nb_nodes += s.nodes[i];
+  out<<"{"<<endl;
+  out<<"  \"nodes\": "<<nb_nodes<<","<<endl;
+  out<<"  \"nodes_per_depth\": [";
+  for(int i=0; i<s.nodes.size(); i++) out<<(i ? ", " : "")<<s.nodes[i];
+  out<<"],"<<endl;
+  out<<"  \"compute_tidlist\": "<<s.nb_tidlist<<","<<endl;
+  out<<"  \"compute_closure\": "<<s.nb_closure<<","<<endl;
+  out<<"  \"reduced_datasets\": {\"count\": "<<s.nb_reduced<<", \"items\": "<<s.reduced_items<<", \"max_items\": "<<s.max_reduced_items<<"},"<<endl;
+  out<<"  \"prunes\": {";
+  for(int i=0; i<NB_PRUNES; i++) out<<(i ? ", " : "")<<"\""<<prune_names[i]<<"\": "<<s.prunes[i];
+  out<<"},"<<endl;
+  out<<"  \"seconds\": {";
+  for(int i=0; i<NB_PHASES; i++) out<<(i ? ", " : "")<<"\""<<phase_names[i]<<"\": "<<s.seconds[i];
+  out<<"},"<<endl;
+  out<<"  \"memory_per_depth\": [";
+  for(int i=0; i<s.memory.size(); i++) out<<(i ? ", " : "")<<s.memory[i];
+  out<<"],"<<endl;
+  out<<"  \"peak_memory\": "<<s.peak_memory<<endl;
+  out<<"}"<<endl;
+}
+
+void print_stats_text(std::ostream& out, const Stats& s)
+{
+  out<<"#nodes per depth:";
+  for(int i=0; i<s.nodes.size(); i++) out<<" "<<s.nodes[i];
+  out<<endl;
+  out<<"#compute_tidlist calls: "<<s.nb_tidlist<<endl;
+  out<<"#compute_closure calls: "<<s.nb_closure<<endl;
+  out<<"#reduced datasets: "<<s.nb_reduced<<" (items: "<<s.reduced_items<<", max: "<<s.max_reduced_items<<")"<<endl;
+  out<<"#prunes:";
+  for(int i=0; i<NB_PRUNES; i++) out<<" "<<prune_names[i]<<" "<<s.prunes[i];
+  out<<endl;
+  out<<"#phase time (s):";
+  for(int i=0; i<NB_PHASES; i++) out<<" "<<phase_names[i]<<" "<<s.seconds[i];
+  out<<endl;
+  out<<"#memory per depth (bytes):";
+  for(int i=0; i<s.memory.size(); i++) out<<" "<<s.memory[i];
+  out<<endl;
+  out<<"#peak memory (bytes): "<<s.peak_memory<<endl;
+}
+
+//print the counters when the program exits (also from exit() in the heuristic search)
+//the counters of the main thread are added to the finished counters before
+static int exit_format = STATS_NONE;
+
+static void print_stats_exit()
+{
+  std::lock_guard<std::mutex> lock(finished_mutex);
+  if(exit_format == STATS_JSON) print_stats_json(cerr, finished_stats);
+  if(exit_format == STATS_TEXT) print_stats_text(cout, finished_stats);
+}
+
+void print_stats_at_exit(int format)
+{
+  if(exit_format == STATS_NONE) atexit(print_stats_exit);
+  exit_format = format;
+}
@@ -0,0 +1,118 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#ifndef STATS_HPP_
+#define STATS_HPP_
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "progress.hpp"
+#include "memory.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////SEARCH INSTRUMENTATION/////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+Each thread counts in its own Stats (no synchronization in the search), the
+counters of the finished threads are summed into a global Stats.
+Phases are timed with the steady clock (wall-clock time).
+ */
+enum StatsFormat { STATS_NONE, STATS_TEXT, STATS_JSON };
+enum Phase { PHASE_LOAD, PHASE_FILTER, PHASE_MINE, PHASE_OUTPUT, NB_PHASES };
+
+//reasons of pruning a node
+enum Prune {
+  PRUNE_TIDLIST,   //less than 2 items contain the tidset
+  PRUNE_SCORE,     //discriminative scores or p-value cannot be reached
+  PRUNE_PPC,       //closure adds a larger tid: the pattern is found from another seed
+  PRUNE_CLOSURE,   //closure adds case tids in the control phase
+  PRUNE_TESTABLE,  //no testable pattern in the subtree (LAMP, Westfall-Young)
+  PRUNE_PREDICT,   //heuristic prediction of the odds ratio
+  NB_PRUNES
+};
+
+struct Stats
+{
+  std::vector<long> nodes;      //number of visited nodes per depth
+  long nb_tidlist;              //calls of compute_tidlist_avx
+  long nb_closure;              //calls of compute_closure_avx
+  long nb_reduced;              //number of reduced datasets
+  long reduced_items;           //total number of items of the reduced datasets
+  long max_reduced_items;       //largest reduced dataset
+  long prunes[NB_PRUNES];       //number of pruned nodes per reason
+  double seconds[NB_PHASES];    //wall-clock time per phase
+  std::vector<long> memory;     //largest number of bytes held when a node is entered, per depth
+  long peak_memory;             //largest number of bytes held by a thread
+  int depth;                    //current depth of the search
+
+  Stats();
+  void add(const Stats& s);
+};
+
+Stats& thread_stats();  //counters of the calling thread
+Stats collect_stats();  //counters of all threads
+void print_stats_json(std::ostream& out, const Stats& s);
+void print_stats_text(std::ostream& out, const Stats& s);
+void print_stats_at_exit(int format);
+
+//count a node at the current depth of the search until the end of the scope
+//(also counted for the progress reporting)
+struct DepthGuard
+{
+  Stats& stats;
+  DepthGuard() : stats(thread_stats()) {
+    if(stats.nodes.size() <= stats.depth) stats.nodes.resize(stats.depth+1, 0);
+    stats.nodes[stats.depth]++;
+    if(stats.memory.size() <= stats.depth) stats.memory.resize(stats.depth+1, 0);
+    if(thread_memory.bytes > stats.memory[stats.depth]) stats.memory[stats.depth] = thread_memory.bytes;
+    stats.depth++;
+    progress_node(stats.depth);
+  }
+  ~DepthGuard() { stats.depth--; }
+};
+
+//add the wall-clock time of a scope (or until stop) to a phase
+struct PhaseTimer
+{
+  Phase phase;
+  int running;
+  std::chrono::steady_clock::time_point begin;
+  PhaseTimer(Phase ph) : phase(ph), running(1), begin(std::chrono::steady_clock::now()) {}
+  void stop() {
+    if(!running) return;
+    running = 0;
+    thread_stats().seconds[phase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  }
+  ~PhaseTimer() { stop(); }
+};
+
+#endif /* STATS_HPP_ */
@@ -0,0 +1,91 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "stream.hpp"
+
+using namespace std;
+
+PatternStream::PatternStream(Miner& m) : miner(m), requested(0), ready(0), done(0), nb_patterns(0)
+{
+}
+
+PatternStream::~PatternStream()
+{
+  cancel();
+  if(generator.joinable()) generator.join();
+}
+
+//search thread: mine until the end or the cancellation
+void PatternStream::run()
+{
+  miner.mine([this](const std::vector<int>& items, int a, int c){ yield(items, a, c); }, &token);
+  std::lock_guard<std::mutex> lock(mutex);
+  done = 1;
+  wakeup.notify_all();
+}
+
+//hand a pattern over to the consumer and suspend the search until the next pull
+void PatternStream::yield(const std::vector<int>& items, int a, int c)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  if(token.cancelled()) return;
+  slot.items = items;
+  slot.a = a;
+  slot.c = c;
+  ready = 1;
+  requested = 0;
+  wakeup.notify_all();
+  wakeup.wait(lock, [this]{ return requested || token.cancelled(); });
+}
+
+bool PatternStream::next(Pattern& pattern)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  if(done || token.cancelled()) return false;
+  requested = 1;
+  if(!generator.joinable()) generator = std::thread(&PatternStream::run, this);
+  else wakeup.notify_all();
+  wakeup.wait(lock, [this]{ return ready || done; });
+  if(!ready) return false;
+  ready = 0;
+  std::swap(pattern, slot);
+  nb_patterns++;
+  return true;
+}
+
+void PatternStream::cancel()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  token.cancel();
+  wakeup.notify_all();
+}
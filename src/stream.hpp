@@ -0,0 +1,96 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef STREAM_HPP_
+#define STREAM_HPP_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "miner.hpp"
+#include "cancel.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////PULL-BASED ENUMERATION/////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+A PatternStream yields the patterns of a Miner one at a time. The search
+runs in its own thread from the first call of next and is suspended in the
+sink after each pattern until the next pull, so no pattern is computed that
+is not asked for. cancel (from any thread) or the destructor stops the
+search at the next node; the remaining subtrees are not visited.
+
+  PatternStream stream(miner);
+  Pattern pattern;
+  while(stream.next(pattern) && (n++ < 100)) { ... }
+
+The Miner must not be used by another thread while its stream is running.
+ */
+struct Pattern
+{
+  std::vector<int> items;  //original ids of the items
+  int a;                   //support in the 1st class
+  int c;                   //support in the 2nd class
+};
+
+class PatternStream
+{
+ public:
+  PatternStream(Miner& miner);
+  ~PatternStream();
+
+  bool next(Pattern& pattern);  //false when the search is finished or cancelled
+  void cancel();
+  long size() const { return nb_patterns; }  //number of patterns yielded so far
+
+ private:
+  void run();
+  void yield(const std::vector<int>& items, int a, int c);
+
+  Miner& miner;
+  CancelToken token;
+  std::thread generator;
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  Pattern slot;
+  int requested;  //the consumer waits for a pattern
+  int ready;      //slot holds a pattern not yet pulled
+  int done;       //the search has returned
+  long nb_patterns;
+
+  PatternStream(const PatternStream&);
+  PatternStream& operator=(const PatternStream&);
+};
+
+#endif /* STREAM_HPP_ */
@@ -0,0 +1,140 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+
+#include "sweep.hpp"
+#include "miner.hpp"
+#include "loader.hpp"
+#include "server.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+int run_sweep(const string& sweep_file, const string& input_file, float max_control, int case_order, int item_order)
+{
+  int nb_case = 0;
+  int nb_control = 0;
+  if(!read_header(input_file, nb_case, nb_control)){
+      cout<<"#error: cannot read "<<input_file<<endl;
+      return 1;
+    }
+
+  //configurations: one line of options each, empty lines and comments are skipped
+  std::vector<MinerConfig> configs;
+  std::vector<string> lines;
+  ifstream sweep(sweep_file.c_str(), ifstream::in);
+  if(!sweep){
+      cout<<"#error: cannot read "<<sweep_file<<endl;
+      return 1;
+    }
+  string line;
+  while(getline(sweep, line)){
+      size_t first = line.find_first_not_of(" \t\r");
+      if((first == string::npos) || (line[first] == '#')) continue;
+      MinerConfig config;
+      config.max_control = max_control;
+      string error;
+      if(parse_query(line, config, nb_case, nb_control, error)){
+	  if((config.method != 0) || (config.lamp_alpha != 0) || (config.wy_alpha != 0)) error = "-heuristics, -lamp and -wy cannot be swept";
+	  else if(config.max_control != max_control) error = "-max changes the items of the patterns, give it on the command line";
+	}
+      if(!error.empty()){
+	  cout<<"#error: "<<line<<": "<<error<<endl;
+	  return 1;
+	}
+      configs.push_back(config);
+      lines.push_back(line);
+    }
+  if(configs.empty()){
+      cout<<"#error: no configuration in "<<sweep_file<<endl;
+      return 1;
+    }
+
+  //loosest thresholds of all configurations (a p-value threshold of 0 is not used)
+  MinerConfig loosest = configs[0];
+  for(int k=1; k<configs.size(); k++){
+      loosest.or_threshold = std::min(loosest.or_threshold, configs[k].or_threshold);
+      loosest.rr_threshold = std::min(loosest.rr_threshold, configs[k].rr_threshold);
+      loosest.arr_threshold = std::min(loosest.arr_threshold, configs[k].arr_threshold);
+      loosest.min_case = std::min(loosest.min_case, configs[k].min_case);
+      loosest.min_case_out = std::min(loosest.min_case_out, configs[k].min_case_out);
+      if((loosest.p_value == 0) || (configs[k].p_value == 0)) loosest.p_value = 0;
+      else loosest.p_value = std::max(loosest.p_value, configs[k].p_value);
+    }
+
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  int nb_trans = 0;
+  Transaction transaction = load_transaction(input_file, loosest.min_case, max_control, case_order, item_order, nb_trans);
+  Miner miner(std::move(transaction), loosest);
+
+  std::vector<std::unique_ptr<ofstream> > outputs;
+  std::vector<long> nb_patterns(configs.size(), 0);
+  for(int k=0; k<configs.size(); k++){
+      string file = sweep_file + "." + to_string(k+1);
+      outputs.push_back(std::unique_ptr<ofstream>(new ofstream(file.c_str(), ofstream::out)));
+      ofstream& out = *outputs[k];
+      if(!out){
+	  cout<<"#error: cannot write "<<file<<endl;
+	  return 1;
+	}
+      out<<"#Sweep configuration: "<<lines[k]<<endl;
+      out<<"#risk thresholds (OR, GR, DS): "<<configs[k].or_threshold<<", "<<configs[k].rr_threshold<<", "<<configs[k].arr_threshold<<endl;
+      if(configs[k].p_value!=0) out<<"#p_value_threshold: "<<configs[k].p_value<<endl;
+      out<<"#min case output: "<<(configs[k].min_case_out/nb_case)*100<<"%"<<endl;
+      out<<endl<<"Output:"<<endl;
+      if(configs[k].p_value!=0) out<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) : p-value )"<<endl;
+      else out<<"#patterns ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) )"<<endl;
+    }
+
+  long nb_traversal = miner.mine([&](const std::vector<int>& items, int a, int c){
+      for(int k=0; k<configs.size(); k++)
+	if(check_pattern_config(a, c, nb_case, nb_control, configs[k])){
+	    print_pattern(*outputs[k], items, a, c, nb_case, nb_control, configs[k].p_value, 0);
+	    nb_patterns[k]++;
+	  }
+    });
+
+  cout<<"#Sweep of "<<configs.size()<<" configurations"<<endl;
+  cout<<"#size of data: "<<nb_trans<<" x "<<miner.transaction.nb_sample<<endl;
+  cout<<"#size of reduced data: "<<miner.transaction.size()<<" x "<<miner.transaction.nb_sample<<endl;
+  cout<<"#patterns of the loosest thresholds: "<<nb_traversal<<endl;
+  for(int k=0; k<configs.size(); k++){
+      *outputs[k]<<endl<<"#nb_patterns "<<nb_patterns[k]<<endl;
+      cout<<"#"<<sweep_file<<"."<<(k+1)<<": "<<lines[k]<<" : "<<nb_patterns[k]<<" patterns"<<endl;
+    }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  cout<<"#running time "<<std::chrono::duration<float>(end-begin).count()<<" s"<<endl;
+  return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+
+
+
+
+#ifndef SWEEP_HPP_
+#define SWEEP_HPP_
+
+#include <string>
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////PARAMETER SWEEP////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+Each line of a sweep file is a configuration of thresholds (-or, -gr, -ds,
+-pval, -min). The exhaustive search runs once with the loosest thresholds of
+all configurations, and each pattern is written to the output of every
+configuration it satisfies (file <sweep file>.<n> for the n-th). The search
+prunes a subtree only when the scores of its root fail, and the scores only
+get worse below it, so each output is the one of a separate run.
+ */
+
+//run the configurations of sweep_file on input_file, return 1 on error
+int run_sweep(const string& sweep_file, const string& input_file, float max_control, int case_order, int item_order);
+
+#endif /* SWEEP_HPP_ */
@@ -0,0 +1,197 @@
+/*
+ *  This file is part of SSDPS,
+ *  Statistically Significant Discriminative Pattern Search
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef TIDSET_EXPR_HPP_
+#define TIDSET_EXPR_HPP_
+
+#include <immintrin.h>
+
+#include "expand_avx.hpp"
+#include "perf.hpp"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////////////
+//////////////LAZY TIDSET EXPRESSIONS////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+/*
+tidset(a) ^ tidset(b), tidset(a) | tidset(b), ... build a tree of operations
+without computing anything. The function that consumes the tree (check_empty,
+count_tids, max_tid, positions, eval) computes it one register at a time in a
+single loop over the registers, without any intermediate Tidset_vector;
+check_empty stops at the 1st register that is not empty. check_expr_score
+scores a candidate from its counts before it is built.
+The tidsets of the leaves must outlive the expression.
+ */
+template <typename E>
+struct TidsetExpr
+{
+  const E& self() const { return static_cast<const E&>(*this); }
+};
+
+//leaf: a tidset
+struct TidsetRef : TidsetExpr<TidsetRef>
+{
+  const Tidset_vector& v;
+  TidsetRef(const Tidset_vector& a) : v(a) {}
+  int size() const { return v.size(); }
+  __m256i reg(int i) const { return v[i]; }
+};
+
+struct OrOp { static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); } };
+struct XorOp { static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); } };
+
+//operation of two expressions of the same size
+template <typename L, typename R, typename Op>
+struct TidsetBinary : TidsetExpr<TidsetBinary<L, R, Op> >
+{
+  L l;
+  R r;
+  TidsetBinary(const L& left, const R& right) : l(left), r(right) {}
+  int size() const { return l.size(); }
+  __m256i reg(int i) const { return Op::apply(l.reg(i), r.reg(i)); }
+};
+
+//registers [begin, end) of an expression, the other registers are empty
+template <typename E>
+struct TidsetRange : TidsetExpr<TidsetRange<E> >
+{
+  E e;
+  int begin;
+  int end;
+  TidsetRange(const E& expr, int b, int en) : e(expr), begin(b), end(en) {}
+  int size() const { return e.size(); }
+  __m256i reg(int i) const { return (i>=begin && i<end) ? e.reg(i) : _mm256_setzero_si256(); }
+};
+
+inline TidsetRef tidset(const Tidset_vector& a)
+{
+  return TidsetRef(a);
+}
+
+template <typename L, typename R>
+TidsetBinary<L, R, OrOp> operator|(const TidsetExpr<L>& l, const TidsetExpr<R>& r)
+{
+  return TidsetBinary<L, R, OrOp>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+TidsetBinary<L, R, XorOp> operator^(const TidsetExpr<L>& l, const TidsetExpr<R>& r)
+{
+  return TidsetBinary<L, R, XorOp>(l.self(), r.self());
+}
+
+template <typename E>
+TidsetRange<E> registers(const TidsetExpr<E>& e, int begin, int end)
+{
+  return TidsetRange<E>(e.self(), begin, end);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//return 1 if the expression is empty, 0 otherwise
+template <typename E>
+int check_empty(const TidsetExpr<E>& expr)
+{
+  const E& e = expr.self();
+  for(int i=0; i<e.size(); i++){
+      __m256i r = e.reg(i);
+      if(!_mm256_testz_si256(r, r)) return 0;
+    }
+  return 1;
+}
+
+//number of tids of the registers [begin, end) of the expression
+template <typename E>
+int count_tids(const TidsetExpr<E>& expr, int begin, int end)
+{
+  const E& e = expr.self();
+  int result = 0;
+  for(int i=begin; i<end; i++){
+      __m256i r = e.reg(i);
+      result += _mm_popcnt_u64(_mm256_extract_epi64(r,0)) + _mm_popcnt_u64(_mm256_extract_epi64(r,1))
+	      + _mm_popcnt_u64(_mm256_extract_epi64(r,2)) + _mm_popcnt_u64(_mm256_extract_epi64(r,3));
+    }
+  return result;
+}
+
+//check_itemset_score of the expression: its cases and controls are counted register by register,
+//without building the tidset
+template <typename E>
+int check_expr_score(const TidsetExpr<E>& expr, Transaction& att, float or_threshold, float rr_threshold, float arr_threshold, float p_threshold, int min_case_out)
+{
+  PerfScope perf(PERF_SCORE);
+  int a = count_tids(expr, 0, att.case_registers);
+  int c = count_tids(expr, att.case_registers, expr.self().size());
+  return check_support_score(a, c, att.nb_case, att.nb_control, or_threshold, rr_threshold, arr_threshold, p_threshold, min_case_out);
+}
+
+//largest tid of the expression (-1 if it is empty), from the last register
+template <typename E>
+int max_tid(const TidsetExpr<E>& expr, Transaction& att)
+{
+  const E& e = expr.self();
+  unsigned long long f[4];
+  for(int i=e.size()-1; i>=0; i--){
+      _mm256_storeu_si256((__m256i*)f, e.reg(i));
+      for(int l=3; l>=0; l--)
+	if(f[l]) return position_tid(i*nb_bits + l*64 + 63 - __builtin_clzll(f[l]), att);
+    }
+  return -1;
+}
+
+//tids of the expression in increasing order
+template <typename E>
+Poslist positions(const TidsetExpr<E>& expr, Transaction& att)
+{
+  const E& e = expr.self();
+  Poslist result;
+  unsigned long long f[4];
+  for(int i=0; i<e.size(); i++){
+      _mm256_storeu_si256((__m256i*)f, e.reg(i));
+      for(int l=0; l<4; l++){
+	  unsigned long long w = f[l];
+	  while(w) {
+	    result.push_back(position_tid(i*nb_bits + l*64 + __builtin_ctzll(w), att));
+	    w &= w-1;
+	  }
+	}
+    }
+  return result;
+}
+
+//tidset of the expression
+template <typename E>
+Tidset_vector eval(const TidsetExpr<E>& expr)
+{
+  const E& e = expr.self();
+  Tidset_vector result;
+  result.reserve(e.size());
+  for(int i=0; i<e.size(); i++) result.push_back(e.reg(i));
+  return result;
+}
+
+#endif /* TIDSET_EXPR_HPP_ */
@@ -34,18 +34,108 @@
  *
  */
 #include <iostream>
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include "utils.hpp"
 
 using namespace std;
 
 
-//TODO: p-value: Pearson extract test cannot calculate large number !
+////////////////////////////////////////////////////////////////////
+//Fisher's exact test
+//the tables are computed once for the sizes of the two classes
+////////////////////////////////////////////////////////////////////
+const long fisher_table_limit = 1L << 23; //maximal number of cached p-values (64MB)
+
+thread_local const FisherTable* fisher_tables = nullptr;
+
+//log of the probability of the table (a, c) given its margins (hypergeometric distribution)
+static double log_hypergeometric(const FisherTable& f, int a, int c)
+{
+  int n = f.nb_case + f.nb_control;
+  return f.log_fact[f.nb_case] - f.log_fact[a] - f.log_fact[f.nb_case-a]
+       + f.log_fact[f.nb_control] - f.log_fact[c] - f.log_fact[f.nb_control-c]
+       - f.log_fact[n] + f.log_fact[a+c] + f.log_fact[n-a-c];
+}
+
+//p-value of (a, c) = sum of the probabilities of the tables with the same margins and at least a cases
+static double fisher_tail(const FisherTable& f, int a, int c)
+{
+  int x = a + c;
+  int max_a = std::min(x, f.nb_case);
+  double p = 0;
+  for(int i=max_a; i>=a; i--)
+    p += exp(log_hypergeometric(f, i, x-i));
+  return std::min(p, 1.0);
+}
+
+//build the log-factorial table and the p-value table of a dataset size
+FisherTable::FisherTable(int nb_case_, int nb_control_) : nb_case(nb_case_), nb_control(nb_control_)
+{
+  int n = nb_case + nb_control;
+  log_fact.assign(n+1, 0);
+  for(int i=2; i<=n; i++)
+    log_fact[i] = lgamma(i+1.0);
+
+  if((long)(nb_case+1)*(nb_control+1) > fisher_table_limit) return; //too large: computed on demand
+
+  //tables with the same support x = a+c share their tail, accumulate it from the largest a
+  table.assign((long)(nb_case+1)*(nb_control+1), 1.0);
+  for(int x=0; x<=n; x++){
+      int min_a = std::max(0, x-nb_control);
+      int max_a = std::min(x, nb_case);
+      double p = 0;
+      for(int a=max_a; a>=min_a; a--){
+	  p += exp(log_hypergeometric(*this, a, x-a));
+	  table[(long)a*(nb_control+1) + (x-a)] = std::min(p, 1.0);
+	}
+    }
+}
+
+double FisherTable::pvalue(int a, int c) const
+{
+  if(!table.empty())
+    return table[(long)a*(nb_control+1) + c];
+  return fisher_tail(*this, a, c);
+}
+
+//the tables still used by a miner are found again instead of being rebuilt
+std::shared_ptr<const FisherTable> get_fisher_table(int nb_case, int nb_control)
+{
+  static std::mutex cache_mutex;
+  static std::map<std::pair<int,int>, std::weak_ptr<const FisherTable> > cache;
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::weak_ptr<const FisherTable>& slot = cache[std::make_pair(nb_case, nb_control)];
+  std::shared_ptr<const FisherTable> tables = slot.lock();
+  if(!tables){
+      tables = std::make_shared<const FisherTable>(nb_case, nb_control);
+      slot = tables;
+    }
+  return tables;
+}
+
+//return log(n!)
+double log_factorial(int n)
+{
+  if(fisher_tables && (n < fisher_tables->log_fact.size())) return fisher_tables->log_fact[n];
+  return lgamma(n+1.0);
+}
+
+//return the one-sided p-value of Fisher's exact test of a pattern covering a cases and c controls
+//(with the tables installed on the thread by a FisherScope)
+double fisher_pvalue(int a, int c)
+{
+  return fisher_tables->pvalue(a, c);
+}
+
+//return the probability of the table (a, b, c, d) computed in log space
 float p_value(int a, int b, int c, int d)
 {
 	int n = a+b+c+d;
-	float p = ( std::tgamma(a+b+1)*std::tgamma(c+d+1)*std::tgamma(a+c+1)*std::tgamma(b+d+1) ) /
-		      ( std::tgamma(a+1)*std::tgamma(b+1)*std::tgamma(c+1)*std::tgamma(d+1)*std::tgamma(n+1) );
-	return p;
+	double p = log_factorial(a+b) + log_factorial(c+d) + log_factorial(a+c) + log_factorial(b+d)
+		     - log_factorial(a) - log_factorial(b) - log_factorial(c) - log_factorial(d) - log_factorial(n);
+	return exp(p);
 }
 
 //return odd ratio
@@ -153,3 +243,36 @@ float info_gain(int a, int b, int c, int d)
   if (isnan(calc)) calc = -1;
   return (base - calc/tot);
 }
+
+//print a pattern: its items then ( % class1 : % class2 : OR : GR : DS : CI(lci-uci) [: p-value] )
+//the exhaustive search separates items by spaces, the heuristic search by commas
+void print_pattern(std::ostream& out, const std::vector<int>& items, int a, int c, int nb_case, int nb_control, float p_threshold, int method,
+		   const std::vector<std::string>* names, const std::vector<int>* samples)
+{
+  for(int i=0; i<items.size(); i++){
+    if(names) out<<(*names)[items[i]];
+    else out<<items[i];
+    if(method!=1) out<<" ";
+    else if(i+1<items.size()) out<<",";
+  }
+  out<<"(";
+  if(c>0) {
+    int b = nb_case - a;
+    int d = nb_control - c;
+    float odd = odd_ratio(a,b,c,d);
+    float rr = risk_ratio(a,b,c,d);
+    float arr = difference_risk(a,b,c,d);
+    float lci = LCI(odd,a,b,c,d);
+    float uci = UCI(odd,a,b,c,d);
+    out<<(100*float(a)/(a+b)) <<" : "<<(100*float(c)/(c+d)) <<" : "<<odd<<" : "<<rr<<" : "<<arr<<" : "<<lci<<"-"<<uci;
+  } else
+    out<<(100*float(a)/nb_case) <<" : "<<(100*float(c)/nb_control);
+  if(p_threshold != 0) out<<" : "<<fisher_pvalue(a,c);
+  out<<")";
+  if(samples){
+    out<<" [";
+    for(int i=0; i<samples->size(); i++) out<<(i ? " " : "")<<(*samples)[i];
+    out<<"]";
+  }
+  out<<endl;
+}
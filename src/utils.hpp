@@ -43,12 +43,44 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <memory>
 
 using namespace std;
 	
 ////////////
 float p_value(int a, int b, int c, int d);
 
+//Fisher's exact test (one-sided, enrichment in the 1st class)
+//the tables of a dataset size are built once and never modified: a miner keeps
+//the tables of its dataset and installs them on the thread of its search with
+//a FisherScope, fisher_pvalue reads the tables installed on the calling thread
+struct FisherTable
+{
+  int nb_case;
+  int nb_control;
+  std::vector<double> log_fact; //log_fact[n] = log(n!) for n <= nb_sample
+  std::vector<double> table;    //table[a*(nb_control+1)+c] = p-value of a pattern covering a cases and c controls (empty: computed on demand)
+
+  FisherTable(int nb_case, int nb_control);
+  double pvalue(int a, int c) const;
+};
+
+//tables of the dataset size, shared by the miners of the same size
+std::shared_ptr<const FisherTable> get_fisher_table(int nb_case, int nb_control);
+
+extern thread_local const FisherTable* fisher_tables;
+
+//installs tables on the current thread until the end of the scope
+struct FisherScope
+{
+  const FisherTable* previous;
+  FisherScope(const FisherTable& tables) : previous(fisher_tables) { fisher_tables = &tables; }
+  ~FisherScope() { fisher_tables = previous; }
+};
+
+double log_factorial(int n);
+double fisher_pvalue(int a, int c);
+
 float odd_ratio(int a, int b, int c, int d);
 float UCI(float odd, int a, int b, int c, int d);
 float LCI(float odd, int a, int b, int c, int d);
@@ -64,4 +96,15 @@ float chi2(int a, int b, int c, int d);
 float nlogn ( float n );
 float info_gain(int a, int b, int c, int d);
 
+//print a pattern and its scores (method 1: heuristic search, items separated by commas)
+//items are printed by their names if names is given (names of the labels of a PLINK fileset),
+//followed by the ids of the samples containing the pattern if samples is given
+void print_pattern(std::ostream& out, const std::vector<int>& items, int a, int c, int nb_case, int nb_control, float p_threshold, int method,
+		   const std::vector<std::string>* names = nullptr, const std::vector<int>* samples = nullptr);
+
+//convert string to int
+constexpr unsigned int str2int(const char* str, int h = 0){
+  return !str[h] ? 5381 : (str2int(str, h+1) * 33) ^ str[h];
+}
+
 #endif /* UTILS_HPP_ */